@@ -0,0 +1,47 @@
+// Drives several MCP23017 chips as one large port.
+// Chips must be at consecutive I2C addresses starting at 0x20.
+
+#include <Adafruit_MCP23X17_Bank.h>
+
+#define NUM_CHIPS 2
+
+Adafruit_MCP23X17_Bank<NUM_CHIPS> bank;
+
+uint16_t inputs[NUM_CHIPS];
+
+void setup() {
+  Serial.begin(9600);
+  //while (!Serial);
+  Serial.println("MCP23xxx Bank Test!");
+
+  if (!bank.begin_I2C()) {
+    Serial.println("Error.");
+    while (1);
+  }
+
+  // first chip drives outputs, the rest are inputs
+  for (uint16_t pin = 0; pin < bank.pinCount(); pin++) {
+    bank.pinMode(pin, (pin < 16) ? OUTPUT : INPUT_PULLUP);
+  }
+
+  Serial.println("Looping...");
+}
+
+void loop() {
+  // walk a single HIGH output across the first chip
+  static uint8_t step = 0;
+  for (uint8_t pin = 0; pin < 16; pin++) {
+    bank.setPin(pin, (pin == step) ? HIGH : LOW);
+  }
+  bank.flush();
+  step = (step + 1) % 16;
+
+  bank.readAll(inputs);
+  for (uint8_t i = 0; i < NUM_CHIPS; i++) {
+    Serial.print(inputs[i], 2);
+    Serial.print(" ");
+  }
+  Serial.println();
+
+  delay(250);
+}
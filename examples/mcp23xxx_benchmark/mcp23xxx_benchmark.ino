@@ -0,0 +1,189 @@
+// Measures the time taken by each library call, with and without the
+// register cache, at several I2C bus clocks. All pins are driven as outputs,
+// so disconnect anything attached to the expander before running.
+//
+// NOTE: Not every microcontroller supports every clock rate. Rates above
+//       400kHz need short wires and suitable pull-up resistors.
+//
+// Define MCP23XXX_STATS in Adafruit_MCP23XXX.h to also print transactions
+// and bytes per call. The RAM used by each chip object is printed first;
+// compare it with MCP23XXX_NO_CACHE and MCP23XXX_NO_SPI defined there (the
+// "with cache" rows then measure the uncached paths again).
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23X17_Async.h>
+#include <Adafruit_MCP23X17_Bank.h>
+
+#define ITERATIONS 100
+#define SAMPLES 32 // per streaming call
+
+// only used for SPI
+#define CS_PIN 6
+
+Adafruit_MCP23X17 mcp;
+Adafruit_MCP23X17_Async async(&mcp);
+Adafruit_MCP23X17_Bank<1> bank; // same chip, through the bank template
+
+const uint32_t clocks[] = {100000, 400000, 1700000};
+
+MCP23XXX_Registers regs;
+uint8_t portRegs[MCP23XXX_OLAT + 1];
+uint8_t samples[SAMPLES];
+uint16_t pairs[SAMPLES];
+MCP23XXX_Run runs[8];
+
+// all pins outputs, no interrupts
+const MCP23XXX_PortConfig config = {0, 0, 0, 0, 0, 0, 0};
+
+// print average micros() per call of the statement
+#define BENCH(name, statement)                                                 \
+  do {                                                                         \
+    resetStats();                                                              \
+    uint32_t start = micros();                                                 \
+    for (uint16_t i = 0; i < ITERATIONS; i++) {                                \
+      statement;                                                               \
+    }                                                                          \
+    uint32_t elapsed = micros() - start;                                       \
+    Serial.print(name);                                                        \
+    Serial.print("\t");                                                        \
+    Serial.print(elapsed / ITERATIONS);                                        \
+    printStats();                                                              \
+  } while (0)
+
+void resetStats() {
+#ifdef MCP23XXX_STATS
+  mcp.resetBusStats();
+#endif
+}
+
+void printStats() {
+#ifdef MCP23XXX_STATS
+  uint32_t transactions = 0;
+  uint32_t bytes = 0;
+  for (uint8_t c = 0; c < MCP23XXX_STATS_CLASSES; c++) {
+    const MCP23XXX_BusStats *stats = mcp.getBusStats(c);
+    transactions += stats->transactions;
+    bytes += stats->bytesRead + stats->bytesWritten;
+  }
+  Serial.print("\t");
+  Serial.print((float)transactions / ITERATIONS);
+  Serial.print("\t");
+  Serial.print((float)bytes / ITERATIONS);
+#endif
+  Serial.println();
+}
+
+void onRead(bool ok, uint16_t value) {
+  (void)ok;
+  (void)value;
+}
+
+void runBenchmarks(uint32_t clock) {
+  BENCH("pinMode", mcp.pinMode(i % 16, OUTPUT));
+  BENCH("pinModeMask", mcp.pinModeMask(0xFFFF, OUTPUT));
+  BENCH("digitalWrite", mcp.digitalWrite(i % 16, i & 1));
+  BENCH("digitalRead", mcp.digitalRead(i % 16));
+  BENCH("writeGPIO", mcp.writeGPIO(i, 0));
+  BENCH("readGPIO", mcp.readGPIO(0));
+  BENCH("writeGPIOAB", mcp.writeGPIOAB(i));
+  BENCH("readGPIOAB", mcp.readGPIOAB());
+  BENCH("digitalWriteMask", mcp.digitalWriteMask(0xFFFF, i));
+  BENCH("batch of 16 writes", {
+    mcp.beginBatch();
+    for (uint8_t pin = 0; pin < 16; pin++)
+      mcp.digitalWrite(pin, (i >> (pin % 8)) & 1);
+    mcp.commit();
+  });
+  BENCH("setupInterrupts", mcp.setupInterrupts(i & 1, false, LOW));
+  BENCH("setupInterruptPin", mcp.setupInterruptPin(i % 16, CHANGE));
+  BENCH("disableInterruptPin", mcp.disableInterruptPin(i % 16));
+  BENCH("getInterruptEnabled", mcp.getInterruptEnabled());
+  BENCH("getLastInterruptPin", mcp.getLastInterruptPin());
+  BENCH("getCapturedInterrupt", mcp.getCapturedInterrupt());
+  BENCH("clearInterrupts", mcp.clearInterrupts());
+  BENCH("serviceInterrupt", mcp.serviceInterrupt());
+  BENCH("readAllRegisters", mcp.readAllRegisters(&regs));
+  BENCH("writeAllRegisters", mcp.writeAllRegisters(&regs));
+  BENCH("readPortRegisters", mcp.readPortRegisters(portRegs, i & 1));
+  BENCH("writePortRegisters", mcp.writePortRegisters(portRegs, i & 1));
+  BENCH("configure", mcp.configure(config));
+  BENCH("configure, verify", mcp.configure(config, true));
+  BENCH("setBusClock", mcp.setBusClock(clock));
+
+  // streaming calls, SAMPLES samples each
+  BENCH("writeGPIOStream", mcp.writeGPIOStream(samples, SAMPLES, i & 1));
+  BENCH("readGPIOStream", mcp.readGPIOStream(samples, SAMPLES, i & 1));
+  BENCH("writeGPIOABStream", mcp.writeGPIOABStream(pairs, SAMPLES));
+  BENCH("readGPIOABStream", mcp.readGPIOABStream(pairs, SAMPLES));
+  BENCH("readGPIOChanges", mcp.readGPIOChanges(runs, 8, SAMPLES));
+
+  // with BANK=1 the registers of each port are contiguous
+  BENCH("setRegisterBank", mcp.setRegisterBank(i & 1));
+  mcp.setRegisterBank(1);
+  BENCH("readPortRegisters BANK1", mcp.readPortRegisters(portRegs, i & 1));
+  BENCH("writePortRegisters BANK1", mcp.writePortRegisters(portRegs, i & 1));
+  BENCH("readGPIOAB BANK1", mcp.readGPIOAB());
+  BENCH("readGPIOChanges BANK1", mcp.readGPIOChanges(runs, 8, SAMPLES));
+  mcp.setRegisterBank(0);
+
+  BENCH("async read + poll", {
+    async.readGPIOABAsync(onRead);
+    async.poll();
+  });
+  BENCH("async 2 writes + poll", {
+    async.writeGPIOABAsync(i);
+    async.writeGPIOABAsync(~i);
+    async.poll();
+  });
+
+  // the bank writes behind the back of the mcp cache
+  BENCH("bank digitalWrite", bank.digitalWrite(i % 16, i & 1));
+  BENCH("bank setPin + flush", {
+    bank.setPin(i % 16, i & 1);
+    bank.flush();
+  });
+  mcp.refreshCache();
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial);
+  Serial.println("MCP23xxx Benchmark! (us per call)");
+  Serial.print("RAM per chip object: ");
+  Serial.print(sizeof(mcp));
+  Serial.println(" bytes");
+
+  // uncomment appropriate mcp.begin
+  if (!mcp.begin_I2C()) {
+  //if (!mcp.begin_SPI(CS_PIN)) {
+    Serial.println("Error.");
+    while (1);
+  }
+  bank.begin_I2C();
+  //bank.begin_SPI(CS_PIN);
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+
+  for (uint8_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+    mcp.setBusClock(clocks[c]);
+    bank.chip(0).setBusClock(clocks[c]);
+    Serial.print("== bus clock ");
+    Serial.print(clocks[c]);
+    Serial.println(" Hz ==");
+
+    mcp.enableCache(false);
+    Serial.println("-- without cache --");
+    runBenchmarks(clocks[c]);
+
+    mcp.enableCache();
+    Serial.println("-- with cache --");
+    runBenchmarks(clocks[c]);
+  }
+
+  // leave all pins as inputs
+  mcp.enableCache(false);
+  mcp.pinModeMask(0xFFFF, INPUT);
+  mcp.setBusClock(100000);
+}
+
+void loop() {
+}
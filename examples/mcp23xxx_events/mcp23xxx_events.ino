@@ -0,0 +1,64 @@
+// Queues timestamped pin change events from the INTA/B line and
+// passes them to per pin callbacks.
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23XXX_Events.h>
+
+#define BUTTON_PIN 1   // MCP23XXX pin used for interrupt
+
+#define INT_PIN 2      // microcontroller pin attached to INTA/B
+
+// only used for SPI
+#define CS_PIN 6
+
+Adafruit_MCP23X17 mcp;
+Adafruit_MCP23XXX_Events events(&mcp);
+
+void onChange() {
+  events.handleInterrupt();
+}
+
+void onButton(uint8_t pin, uint8_t level, uint32_t timestamp) {
+  Serial.print("Pin ");
+  Serial.print(pin);
+  Serial.print(level ? " HIGH" : " LOW");
+  Serial.print(" at ");
+  Serial.println(timestamp);
+}
+
+void setup() {
+  Serial.begin(9600);
+  //while (!Serial);
+  Serial.println("MCP23xxx Events Test!");
+
+  // uncomment appropriate mcp.begin
+  if (!mcp.begin_I2C()) {
+  //if (!mcp.begin_SPI(CS_PIN)) {
+    Serial.println("Error.");
+    while (1);
+  }
+
+  // mirror INTA/B, active drive, signaled with a LOW
+  mcp.setupInterrupts(true, false, LOW);
+
+  mcp.pinMode(BUTTON_PIN, INPUT_PULLUP);
+  mcp.setupInterruptPin(BUTTON_PIN, CHANGE);
+  mcp.clearInterrupts();
+
+  events.onPin(BUTTON_PIN, onButton);
+
+  pinMode(INT_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(INT_PIN), onChange, FALLING);
+
+  Serial.println("Looping...");
+}
+
+void loop() {
+  events.capture();
+  events.drain();
+
+  if (events.overflows()) {
+    Serial.print("Dropped events: ");
+    Serial.println(events.overflows());
+  }
+}
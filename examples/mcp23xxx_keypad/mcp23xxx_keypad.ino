@@ -0,0 +1,49 @@
+// Scans a key matrix with rows on GPA0-GPA3 and columns on GPB0-GPB3.
+// With a diode on every key, begin(false) scans faster.
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23X17_Keypad.h>
+
+#define ROWS 4
+#define COLS 4
+
+#define INT_PIN 7      // microcontroller pin attached to INTB
+
+Adafruit_MCP23X17 mcp;
+Adafruit_MCP23X17_Keypad keypad(&mcp, ROWS, COLS, INT_PIN);
+
+void setup() {
+  Serial.begin(9600);
+  //while (!Serial);
+  Serial.println("MCP23xxx Keypad Test!");
+
+  if (!mcp.begin_I2C()) {
+    Serial.println("Error.");
+    while (1);
+  }
+
+  // INTB is active drive, signaled with a LOW
+  mcp.setupInterrupts(false, false, LOW);
+  pinMode(INT_PIN, INPUT);
+
+  keypad.begin();
+
+  Serial.println("Looping...");
+}
+
+void loop() {
+  // only scans after INTB signals a key press, or while keys are held
+  if (keypad.update()) {
+    for (uint8_t row = 0; row < ROWS; row++) {
+      for (uint8_t col = 0; col < COLS; col++) {
+        Serial.print(keypad.isPressed(row, col) ? "X" : ".");
+      }
+      Serial.println();
+    }
+    if (keypad.ghosting()) {
+      Serial.println("Ghosting! Some keys may be wrong.");
+    }
+    Serial.println();
+  }
+  delay(10);  // debounce
+}
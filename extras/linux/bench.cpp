@@ -0,0 +1,153 @@
+/*!
+ * @file bench.cpp
+ *
+ * System calls and wall time per library call on a Linux bus, with the
+ * register cache off and on. Every bus transfer is one ioctl(), so the
+ * system call count is the transfer count. Select the bus as in bus.h.
+ */
+
+#include "bus.h"
+
+#include <LinuxBus.h>
+#include <stdio.h>
+
+#define BENCH_REPEAT 100 //!< Calls per measurement
+#define BENCH_SAMPLES 32 //!< Samples per streaming call
+
+/*! @brief One row of the table. */
+typedef struct {
+  const char *name;                              ///< Call being measured
+  void (*run)(Adafruit_MCP23X17 *mcp, uint8_t i); ///< Call, i counts up
+} Bench;
+
+static uint8_t samples[BENCH_SAMPLES];
+static uint16_t pairs[BENCH_SAMPLES];
+static MCP23XXX_Registers regs;
+
+static void pinMode(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  mcp->pinMode(1, (i & 1) ? INPUT : OUTPUT);
+}
+
+static void digitalRead(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->digitalRead(8);
+}
+
+static void digitalWrite(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  mcp->digitalWrite(0, i & 1);
+}
+
+static void readGPIOAB(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->readGPIOAB();
+}
+
+static void writeGPIOAB(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  mcp->writeGPIOAB(i);
+}
+
+static void digitalWriteMask(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  mcp->digitalWriteMask(0x00F0, i << 4);
+}
+
+static void batch(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  mcp->beginBatch();
+  for (uint8_t pin = 0; pin < 8; pin++)
+    mcp->digitalWrite(pin, (i >> pin) & 1);
+  mcp->commit();
+}
+
+static void configure(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  MCP23XXX_PortConfig config = {0xFF00, 0, 0xFF00, 0, 0, 0xFF00, i};
+  mcp->configure(config);
+}
+
+static void serviceInterrupt(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->serviceInterrupt(true);
+}
+
+static void readAllRegisters(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->readAllRegisters(&regs);
+}
+
+static void writeAllRegisters(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->writeAllRegisters(&regs);
+}
+
+static void writeGPIOStream(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->writeGPIOStream(samples, BENCH_SAMPLES);
+}
+
+static void readGPIOStream(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->readGPIOStream(samples, BENCH_SAMPLES, 1);
+}
+
+static void readGPIOABStream(Adafruit_MCP23X17 *mcp, uint8_t i) {
+  (void)i;
+  mcp->readGPIOABStream(pairs, BENCH_SAMPLES);
+}
+
+static const Bench benches[] = {
+    {"pinMode", pinMode},
+    {"digitalRead", digitalRead},
+    {"digitalWrite", digitalWrite},
+    {"readGPIOAB", readGPIOAB},
+    {"writeGPIOAB", writeGPIOAB},
+    {"digitalWriteMask", digitalWriteMask},
+    {"batch of 8 writes", batch},
+    {"configure", configure},
+    {"serviceInterrupt", serviceInterrupt},
+    {"readAllRegisters", readAllRegisters},
+    {"writeAllRegisters", writeAllRegisters},
+    {"writeGPIOStream x32", writeGPIOStream},
+    {"readGPIOStream x32", readGPIOStream},
+    {"readGPIOABStream x32", readGPIOABStream},
+};
+
+/*!
+    @brief  Measure one table row, averaged over BENCH_REPEAT calls.
+    @param mcp started chip
+    @param bench row to measure
+    @param cache true to enable the register cache
+    @param us set to the wall time per call in microseconds
+    @returns system calls per call
+*/
+static float measure(Adafruit_MCP23X17 *mcp, const Bench &bench, bool cache,
+                     float *us) {
+  mcp->enableCache(cache);
+  mcp->pinModeMask(0x00FF, OUTPUT);
+  mcp->pinModeMask(0xFF00, INPUT_PULLUP);
+  mcp->readAllRegisters(&regs);
+
+  uint32_t calls = busSyscalls();
+  unsigned long start = micros();
+  for (uint8_t i = 0; i < BENCH_REPEAT; i++)
+    bench.run(mcp, i);
+  *us = (float)(micros() - start) / BENCH_REPEAT;
+  return (float)(busSyscalls() - calls) / BENCH_REPEAT;
+}
+
+int main() {
+  Adafruit_MCP23X17 mcp;
+
+  if (!busBegin(&mcp)) {
+    printf("no MCP23X17 on %s\n", busName());
+    return 1;
+  }
+  printf("%s\n%-24s %9s %9s %9s %9s\n", busName(), "call", "syscalls",
+         "cached", "us", "us cached");
+  for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+    float us, usCached;
+    float calls = measure(&mcp, benches[i], false, &us);
+    float cached = measure(&mcp, benches[i], true, &usCached);
+
+    printf("%-24s %9.2f %9.2f %9.1f %9.1f\n", benches[i].name, calls, cached,
+           us, usCached);
+  }
+  return 0;
+}
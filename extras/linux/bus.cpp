@@ -0,0 +1,44 @@
+/*!
+ * @file bus.cpp
+ *
+ * Bus selection for the Linux tests and benchmark, see bus.h.
+ */
+
+#include "bus.h"
+
+#include <stdlib.h>
+
+/*!
+    @brief  The adapter named by MCP23XXX_I2C.
+    @returns adapter, opened on first use
+*/
+static TwoWire *i2cBus() {
+  static TwoWire bus(getenv("MCP23XXX_I2C") ? getenv("MCP23XXX_I2C")
+                                            : "/dev/i2c-1");
+  return &bus;
+}
+
+/*!
+    @brief  Start a chip on the selected bus.
+    @param mcp chip to start
+    @return true if successful, otherwise false.
+*/
+bool busBegin(Adafruit_MCP23X17 *mcp) {
+  static SPIClass spi(getenv("MCP23XXX_SPI"));
+  const char *addr = getenv("MCP23XXX_ADDR");
+
+  if (spi.device)
+    return mcp->begin_SPI(0, &spi, addr ? strtol(addr, nullptr, 0) : 0);
+  return mcp->begin_I2C(addr ? strtol(addr, nullptr, 0) : MCP23XXX_ADDR,
+                        i2cBus());
+}
+
+/*!
+    @brief  Name of the selected bus device.
+    @returns device path
+*/
+const char *busName() {
+  if (getenv("MCP23XXX_SPI"))
+    return getenv("MCP23XXX_SPI");
+  return getenv("MCP23XXX_I2C") ? getenv("MCP23XXX_I2C") : "/dev/i2c-1";
+}
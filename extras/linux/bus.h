@@ -0,0 +1,18 @@
+/*!
+ * @file bus.h
+ *
+ * Bus selection for the Linux tests and benchmark. MCP23XXX_I2C names the
+ * i2c-dev adapter (default /dev/i2c-1), or MCP23XXX_SPI a spidev device to
+ * use SPI instead. MCP23XXX_ADDR is the chip address, default 0x20 on I2C
+ * and 0 on SPI.
+ */
+
+#ifndef __BUS_H__
+#define __BUS_H__
+
+#include <Adafruit_MCP23X17.h>
+
+bool busBegin(Adafruit_MCP23X17 *mcp);
+const char *busName();
+
+#endif
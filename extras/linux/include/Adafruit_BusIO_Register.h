@@ -0,0 +1,43 @@
+/*!
+ * @file Adafruit_BusIO_Register.h
+ *
+ * Adafruit BusIO register access for Linux, on top of the i2c-dev and
+ * spidev devices. Registers are transferred as plain bytes, width and byte
+ * order are not used.
+ */
+
+#ifndef __LINUX_ADAFRUIT_BUSIO_REGISTER_H__
+#define __LINUX_ADAFRUIT_BUSIO_REGISTER_H__
+
+#include <Adafruit_I2CDevice.h>
+#include <Adafruit_SPIDevice.h>
+
+typedef enum _Adafruit_BusIO_SPIRegType {
+  ADDRBIT8_HIGH_TOREAD = 0,
+  AD8_HIGH_TOREAD_AD7_HIGH_TOINC = 1,
+  ADDRBIT8_HIGH_TOWRITE = 2,
+  ADDRESSED_OPCODE_BIT0_LOW_TO_WRITE = 3,
+} Adafruit_BusIO_SPIRegType;
+
+class Adafruit_BusIO_Register {
+public:
+  Adafruit_BusIO_Register(Adafruit_I2CDevice *i2cdevice,
+                          Adafruit_SPIDevice *spidevice,
+                          Adafruit_BusIO_SPIRegType type, uint16_t reg_addr,
+                          uint8_t width = 1, uint8_t byteorder = LSBFIRST,
+                          uint8_t address_width = 1);
+
+  bool read(uint8_t *buffer, uint8_t len);
+  bool write(uint8_t *buffer, uint8_t len);
+
+private:
+  uint8_t prefix(uint8_t *buffer, bool isWrite);
+
+  Adafruit_I2CDevice *i2c;
+  Adafruit_SPIDevice *spi;
+  Adafruit_BusIO_SPIRegType type;
+  uint16_t addr;
+  uint8_t addrWidth;
+};
+
+#endif
@@ -0,0 +1,37 @@
+/*!
+ * @file Adafruit_I2CDevice.h
+ *
+ * Adafruit BusIO I2C device for Linux i2c-dev. A write followed by a read
+ * is one I2C_RDWR call with a repeated start. Adapters without plain I2C
+ * support, such as i2c-stub, are driven with SMBus I2C block transfers.
+ */
+
+#ifndef __LINUX_ADAFRUIT_I2CDEVICE_H__
+#define __LINUX_ADAFRUIT_I2CDEVICE_H__
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire);
+
+  uint8_t address(void) { return addr; }
+  bool begin(bool addr_detect = true);
+  bool detected(void);
+
+  bool read(uint8_t *buffer, size_t len, bool stop = true);
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false);
+  bool setSpeed(uint32_t desiredclk);
+  size_t maxBufferSize();
+
+private:
+  uint8_t addr;
+  TwoWire *wire;
+};
+
+#endif
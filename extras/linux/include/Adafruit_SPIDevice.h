@@ -0,0 +1,50 @@
+/*!
+ * @file Adafruit_SPIDevice.h
+ *
+ * Adafruit BusIO SPI device for Linux spidev. A write followed by a read
+ * is one SPI_IOC_MESSAGE call with chip select held. Software SPI is not
+ * available, begin() fails for devices built with pin numbers.
+ */
+
+#ifndef __LINUX_ADAFRUIT_SPIDEVICE_H__
+#define __LINUX_ADAFRUIT_SPIDEVICE_H__
+
+#include <Arduino.h>
+#include <SPI.h>
+
+typedef enum {
+  SPI_BITORDER_MSBFIRST = MSBFIRST,
+  SPI_BITORDER_LSBFIRST = LSBFIRST,
+} BusIOBitOrder;
+
+class Adafruit_SPIDevice {
+public:
+  Adafruit_SPIDevice(int8_t cspin, uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0, SPIClass *theSPI = &SPI);
+  Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso, int8_t mosi,
+                     uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0);
+  ~Adafruit_SPIDevice();
+
+  bool begin(void);
+  bool read(uint8_t *buffer, size_t len, uint8_t sendvalue = 0xFF);
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       uint8_t sendvalue = 0xFF);
+
+private:
+  Adafruit_SPIDevice(const Adafruit_SPIDevice &) = delete;
+  Adafruit_SPIDevice &operator=(const Adafruit_SPIDevice &) = delete;
+
+  SPIClass *spi;
+  uint32_t freq;
+  uint8_t dataMode;
+  bool lsbFirst;
+  int handle = -1;
+};
+
+#endif
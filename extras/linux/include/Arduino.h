@@ -0,0 +1,37 @@
+/*!
+ * @file Arduino.h
+ *
+ * Minimal Arduino API for running the library on Linux. Time comes from
+ * CLOCK_MONOTONIC and digitalRead() reads GPIO lines through the GPIO
+ * character device, see LinuxBus.h.
+ */
+
+#ifndef __LINUX_ARDUINO_H__
+#define __LINUX_ARDUINO_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+
+#endif
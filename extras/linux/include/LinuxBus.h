@@ -0,0 +1,20 @@
+/*!
+ * @file LinuxBus.h
+ *
+ * Linux specific additions to the Arduino API: the GPIO chip used by
+ * pinMode() and digitalRead(), waiting for an interrupt line without
+ * polling, and a count of bus system calls for benchmarks.
+ */
+
+#ifndef __LINUX_BUS_H__
+#define __LINUX_BUS_H__
+
+#include <Arduino.h>
+
+void setGPIOChip(const char *device);
+int waitForInterrupt(uint8_t pin, int timeoutMs);
+
+int busIoctl(int fd, unsigned long request, void *arg);
+uint32_t busSyscalls();
+
+#endif
@@ -0,0 +1,28 @@
+/*!
+ * @file SPI.h
+ *
+ * Arduino SPI library for Linux. A SPIClass names one spidev device; chip
+ * select is driven by the kernel for that device. The global SPI is
+ * /dev/spidev0.0.
+ */
+
+#ifndef __LINUX_SPI_H__
+#define __LINUX_SPI_H__
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+class SPIClass {
+public:
+  SPIClass(const char *device) : device(device) {}
+
+  const char *device; ///< spidev device path
+};
+
+extern SPIClass SPI;
+
+#endif
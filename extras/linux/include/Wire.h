@@ -0,0 +1,40 @@
+/*!
+ * @file Wire.h
+ *
+ * Arduino Wire library for Linux. A TwoWire is one i2c-dev adapter, opened
+ * on first use. The global Wire is /dev/i2c-1.
+ */
+
+#ifndef __LINUX_WIRE_H__
+#define __LINUX_WIRE_H__
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  TwoWire(const char *device);
+  ~TwoWire();
+
+  bool begin();
+  void end();
+  void setClock(uint32_t clock);
+  uint32_t getClock();
+
+  int fd();
+  unsigned long functions();
+  bool select(uint8_t addr);
+
+private:
+  TwoWire(const TwoWire &) = delete;
+  TwoWire &operator=(const TwoWire &) = delete;
+
+  const char *device;
+  int handle = -1;
+  unsigned long funcs = 0;
+  int16_t slave = -1;
+  uint32_t clock = 100000;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,24 @@
+#!/bin/sh
+# Run the Linux backend tests and benchmark on the i2c-stub kernel module,
+# which adds an SMBus adapter with a chip of 256 plain registers at 0x20.
+# Needs root to load the modules.
+set -e
+cd "$(dirname "$0")"
+
+modprobe i2c-dev
+modprobe i2c-stub chip_addr=0x20
+trap 'rmmod i2c-stub' EXIT
+
+for adapter in /sys/bus/i2c/devices/i2c-*; do
+  if grep -q "SMBus stub driver" "$adapter/name"; then
+    MCP23XXX_I2C=/dev/$(basename "$adapter")
+  fi
+done
+if [ -z "$MCP23XXX_I2C" ]; then
+  echo "i2c-stub adapter not found"
+  exit 1
+fi
+export MCP23XXX_I2C
+
+./run_linux_tests
+./run_linux_bench
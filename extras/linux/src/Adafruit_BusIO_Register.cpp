@@ -0,0 +1,93 @@
+/*!
+ * @file Adafruit_BusIO_Register.cpp
+ *
+ * Adafruit BusIO register access for Linux. Each read or write is a single
+ * device transfer, so a single system call.
+ */
+
+#include <Adafruit_BusIO_Register.h>
+
+/*!
+    @brief  Describe a register, or a block of registers.
+    @param i2cdevice I2C device, or nullptr for SPI
+    @param spidevice SPI device, or nullptr for I2C
+    @param type how the SPI address marks reads and writes
+    @param reg_addr register address, with the SPI opcode in the high byte
+    for ADDRESSED_OPCODE_BIT0_LOW_TO_WRITE
+    @param width unused, registers are read as bytes
+    @param byteorder unused, registers are read as bytes
+    @param address_width number of address bytes
+*/
+Adafruit_BusIO_Register::Adafruit_BusIO_Register(
+    Adafruit_I2CDevice *i2cdevice, Adafruit_SPIDevice *spidevice,
+    Adafruit_BusIO_SPIRegType type, uint16_t reg_addr, uint8_t width,
+    uint8_t byteorder, uint8_t address_width) {
+  (void)width;
+  (void)byteorder;
+  i2c = i2cdevice;
+  spi = spidevice;
+  this->type = type;
+  addr = reg_addr;
+  addrWidth = address_width;
+}
+
+/*!
+    @brief  Build the address bytes sent before the data, as BusIO does.
+    @param buffer buffer for up to 3 bytes
+    @param isWrite true for a write
+    @returns number of address bytes
+*/
+uint8_t Adafruit_BusIO_Register::prefix(uint8_t *buffer, bool isWrite) {
+  buffer[0] = addr & 0xFF;
+  buffer[1] = addr >> 8;
+  if (i2c)
+    return addrWidth;
+
+  switch (type) {
+  case ADDRBIT8_HIGH_TOREAD:
+    buffer[0] = isWrite ? (buffer[0] & ~0x80) : (buffer[0] | 0x80);
+    break;
+  case AD8_HIGH_TOREAD_AD7_HIGH_TOINC:
+    buffer[0] = (isWrite ? (buffer[0] & ~0x80) : (buffer[0] | 0x80)) | 0x40;
+    break;
+  case ADDRBIT8_HIGH_TOWRITE:
+    buffer[0] = isWrite ? (buffer[0] | 0x80) : (buffer[0] & ~0x80);
+    break;
+  case ADDRESSED_OPCODE_BIT0_LOW_TO_WRITE:
+    // opcode in the high byte, then the register
+    buffer[0] = isWrite ? ((addr >> 8) & ~0x01) : ((addr >> 8) | 0x01);
+    buffer[1] = addr & 0xFF;
+    return addrWidth + 1;
+  }
+  return addrWidth;
+}
+
+/*!
+    @brief  Read consecutive registers.
+    @param buffer buffer for the values
+    @param len number of bytes
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_BusIO_Register::read(uint8_t *buffer, uint8_t len) {
+  uint8_t address[3];
+  uint8_t count = prefix(address, false);
+
+  if (i2c)
+    return i2c->write_then_read(address, count, buffer, len);
+  return spi && spi->write_then_read(address, count, buffer, len);
+}
+
+/*!
+    @brief  Write consecutive registers.
+    @param buffer values to write
+    @param len number of bytes
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  uint8_t address[3];
+  uint8_t count = prefix(address, true);
+
+  if (i2c)
+    return i2c->write(buffer, len, true, address, count);
+  return spi && spi->write(buffer, len, address, count);
+}
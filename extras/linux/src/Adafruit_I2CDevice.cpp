@@ -0,0 +1,171 @@
+/*!
+ * @file Adafruit_I2CDevice.cpp
+ *
+ * Adafruit BusIO I2C device for Linux i2c-dev.
+ */
+
+#include <Adafruit_I2CDevice.h>
+#include <LinuxBus.h>
+
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+
+#define I2C_MAX_MSG 256 //!< Largest message built for I2C_RDWR
+
+/*!
+    @brief  Create a device on an adapter.
+    @param addr 7 bit I2C address
+    @param theWire adapter, default Wire (/dev/i2c-1)
+*/
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire) {
+  this->addr = addr;
+  wire = theWire;
+}
+
+/*!
+    @brief  Open the adapter and optionally check that the device answers.
+    @param addr_detect true to check for the device
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  if (!wire->begin())
+    return false;
+  return !addr_detect || detected();
+}
+
+/*!
+    @brief  Check that the device acknowledges its address.
+    @return true if it does, otherwise false.
+*/
+bool Adafruit_I2CDevice::detected(void) {
+  uint8_t value;
+
+  if (wire->functions() & I2C_FUNC_SMBUS_QUICK) {
+    struct i2c_smbus_ioctl_data quick = {I2C_SMBUS_WRITE, 0, I2C_SMBUS_QUICK,
+                                         nullptr};
+    return wire->select(addr) && busIoctl(wire->fd(), I2C_SMBUS, &quick) >= 0;
+  }
+  return read(&value, 1);
+}
+
+/*!
+    @brief  Read from the device.
+    @param buffer buffer for the data
+    @param len number of bytes, only 1 on SMBus adapters
+    @param stop unused, every transfer ends with a stop
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  (void)stop;
+  if (wire->functions() & I2C_FUNC_I2C) {
+    struct i2c_msg msg = {addr, I2C_M_RD, (uint16_t)len, buffer};
+    struct i2c_rdwr_ioctl_data rdwr = {&msg, 1};
+    return busIoctl(wire->fd(), I2C_RDWR, &rdwr) >= 0;
+  }
+
+  union i2c_smbus_data data;
+  struct i2c_smbus_ioctl_data smbus = {I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE,
+                                       &data};
+  if (len != 1 || !wire->select(addr) ||
+      busIoctl(wire->fd(), I2C_SMBUS, &smbus) < 0)
+    return false;
+  buffer[0] = data.byte;
+  return true;
+}
+
+/*!
+    @brief  Write to the device in one message.
+    @param buffer data to write
+    @param len number of bytes
+    @param stop unused, every transfer ends with a stop
+    @param prefix_buffer bytes sent before buffer, such as a register
+    @param prefix_len number of prefix bytes
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  uint8_t msg[I2C_MAX_MSG];
+
+  (void)stop;
+  if (prefix_len + len > maxBufferSize())
+    return false;
+  memcpy(msg, prefix_buffer, prefix_len);
+  memcpy(msg + prefix_len, buffer, len);
+  len += prefix_len;
+
+  if (wire->functions() & I2C_FUNC_I2C) {
+    struct i2c_msg i2c = {addr, 0, (uint16_t)len, msg};
+    struct i2c_rdwr_ioctl_data rdwr = {&i2c, 1};
+    return busIoctl(wire->fd(), I2C_RDWR, &rdwr) >= 0;
+  }
+
+  // SMBus: the first byte is the command (register), the rest a block
+  union i2c_smbus_data data;
+  struct i2c_smbus_ioctl_data smbus = {I2C_SMBUS_WRITE, msg[0],
+                                       I2C_SMBUS_I2C_BLOCK_DATA, &data};
+  if (!len)
+    return false;
+  if (len == 1)
+    smbus.size = I2C_SMBUS_BYTE;
+  data.block[0] = len - 1;
+  memcpy(data.block + 1, msg + 1, len - 1);
+  return wire->select(addr) && busIoctl(wire->fd(), I2C_SMBUS, &smbus) >= 0;
+}
+
+/*!
+    @brief  Write, then read with a repeated start, in one system call.
+    @param write_buffer data to write
+    @param write_len number of bytes to write
+    @param read_buffer buffer for the data read
+    @param read_len number of bytes to read
+    @param stop unused, I2C_RDWR always uses a repeated start
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len, uint8_t *read_buffer,
+                                         size_t read_len, bool stop) {
+  (void)stop;
+  if (!read_len)
+    return write(write_buffer, write_len);
+
+  if (wire->functions() & I2C_FUNC_I2C) {
+    struct i2c_msg msgs[2] = {
+        {addr, 0, (uint16_t)write_len, (uint8_t *)write_buffer},
+        {addr, I2C_M_RD, (uint16_t)read_len, read_buffer}};
+    struct i2c_rdwr_ioctl_data rdwr = {msgs, 2};
+    return busIoctl(wire->fd(), I2C_RDWR, &rdwr) >= 0;
+  }
+
+  // SMBus: a one byte command followed by a block read
+  union i2c_smbus_data data;
+  struct i2c_smbus_ioctl_data smbus = {I2C_SMBUS_READ, write_buffer[0],
+                                       I2C_SMBUS_I2C_BLOCK_DATA, &data};
+  if (write_len != 1 || read_len > I2C_SMBUS_BLOCK_MAX)
+    return false;
+  data.block[0] = read_len;
+  if (!wire->select(addr) || busIoctl(wire->fd(), I2C_SMBUS, &smbus) < 0)
+    return false;
+  memcpy(read_buffer, data.block + 1, read_len);
+  return true;
+}
+
+/*!
+    @brief  Change the bus clock. Not possible on Linux, where the adapter
+    clock is set by the kernel.
+    @param desiredclk clock in Hz
+    @return false
+*/
+bool Adafruit_I2CDevice::setSpeed(uint32_t desiredclk) {
+  (void)desiredclk;
+  return false;
+}
+
+/*!
+    @brief  Largest transfer, including the register byte.
+    @returns bytes
+*/
+size_t Adafruit_I2CDevice::maxBufferSize() {
+  return (wire->functions() & I2C_FUNC_I2C) ? I2C_MAX_MSG
+                                            : I2C_SMBUS_BLOCK_MAX + 1;
+}
@@ -0,0 +1,160 @@
+/*!
+ * @file Adafruit_SPIDevice.cpp
+ *
+ * Adafruit BusIO SPI device for Linux spidev.
+ */
+
+#include <Adafruit_SPIDevice.h>
+#include <LinuxBus.h>
+
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+#include <unistd.h>
+
+/*!
+    @brief  Create a device on a spidev device. Chip select belongs to the
+    spidev device, cspin is not used.
+    @param cspin unused
+    @param freq clock in Hz
+    @param dataOrder bit order
+    @param dataMode SPI_MODE0 to SPI_MODE3
+    @param theSPI spidev device, default SPI (/dev/spidev0.0)
+*/
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode, SPIClass *theSPI) {
+  (void)cspin;
+  spi = theSPI;
+  this->freq = freq;
+  this->dataMode = dataMode;
+  lsbFirst = (dataOrder == SPI_BITORDER_LSBFIRST);
+}
+
+/*!
+    @brief  Software SPI device, not available on Linux.
+    @param cspin unused
+    @param sck unused
+    @param miso unused
+    @param mosi unused
+    @param freq clock in Hz
+    @param dataOrder bit order
+    @param dataMode SPI_MODE0 to SPI_MODE3
+*/
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso,
+                                       int8_t mosi, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode) {
+  (void)cspin;
+  (void)sck;
+  (void)miso;
+  (void)mosi;
+  spi = nullptr;
+  this->freq = freq;
+  this->dataMode = dataMode;
+  lsbFirst = (dataOrder == SPI_BITORDER_LSBFIRST);
+}
+
+Adafruit_SPIDevice::~Adafruit_SPIDevice() {
+  if (handle >= 0)
+    close(handle);
+}
+
+/*!
+    @brief  Open the spidev device and set mode, bit order and clock.
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_SPIDevice::begin(void) {
+  uint8_t mode = dataMode;
+  uint8_t lsb = lsbFirst;
+  uint8_t bits = 8;
+
+  if (handle >= 0)
+    return true;
+  if (!spi || (handle = open(spi->device, O_RDWR | O_CLOEXEC)) < 0)
+    return false;
+  if (busIoctl(handle, SPI_IOC_WR_MODE, &mode) < 0 ||
+      busIoctl(handle, SPI_IOC_WR_LSB_FIRST, &lsb) < 0 ||
+      busIoctl(handle, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+      busIoctl(handle, SPI_IOC_WR_MAX_SPEED_HZ, &freq) < 0) {
+    close(handle);
+    handle = -1;
+    return false;
+  }
+  return true;
+}
+
+/*!
+    @brief  Fill in one transfer of a message.
+    @param xfer transfer to fill
+    @param tx bytes to send, or nullptr
+    @param rx buffer for received bytes, or nullptr
+    @param len number of bytes
+    @param freq clock in Hz
+*/
+static void setTransfer(struct spi_ioc_transfer *xfer, const uint8_t *tx,
+                        uint8_t *rx, size_t len, uint32_t freq) {
+  memset(xfer, 0, sizeof(*xfer));
+  xfer->tx_buf = (uintptr_t)tx;
+  xfer->rx_buf = (uintptr_t)rx;
+  xfer->len = len;
+  xfer->speed_hz = freq;
+  xfer->bits_per_word = 8;
+}
+
+/*!
+    @brief  Read from the device.
+    @param buffer buffer for the data
+    @param len number of bytes
+    @param sendvalue byte sent while reading
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_SPIDevice::read(uint8_t *buffer, size_t len, uint8_t sendvalue) {
+  struct spi_ioc_transfer xfer;
+
+  memset(buffer, sendvalue, len);
+  setTransfer(&xfer, buffer, buffer, len, freq);
+  return busIoctl(handle, SPI_IOC_MESSAGE(1), &xfer) >= 0;
+}
+
+/*!
+    @brief  Write to the device with chip select held across prefix and
+    data.
+    @param buffer data to write
+    @param len number of bytes
+    @param prefix_buffer bytes sent before buffer, such as opcode and
+    register
+    @param prefix_len number of prefix bytes
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_SPIDevice::write(const uint8_t *buffer, size_t len,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  struct spi_ioc_transfer xfer[2];
+  uint8_t n = 0;
+
+  if (prefix_len)
+    setTransfer(&xfer[n++], prefix_buffer, nullptr, prefix_len, freq);
+  if (len)
+    setTransfer(&xfer[n++], buffer, nullptr, len, freq);
+  return n && busIoctl(handle, SPI_IOC_MESSAGE(n), xfer) >= 0;
+}
+
+/*!
+    @brief  Write, then read with chip select held, in one system call.
+    @param write_buffer data to write
+    @param write_len number of bytes to write
+    @param read_buffer buffer for the data read
+    @param read_len number of bytes to read
+    @param sendvalue byte sent while reading
+    @return true if successful, otherwise false.
+*/
+bool Adafruit_SPIDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len, uint8_t *read_buffer,
+                                         size_t read_len, uint8_t sendvalue) {
+  struct spi_ioc_transfer xfer[2];
+
+  memset(read_buffer, sendvalue, read_len);
+  setTransfer(&xfer[0], write_buffer, nullptr, write_len, freq);
+  setTransfer(&xfer[1], read_buffer, read_buffer, read_len, freq);
+  return busIoctl(handle, SPI_IOC_MESSAGE(2), xfer) >= 0;
+}
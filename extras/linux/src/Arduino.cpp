@@ -0,0 +1,179 @@
+/*!
+ * @file Arduino.cpp
+ *
+ * Time, GPIO lines and the bus system call counter for the Linux build.
+ * GPIO lines are requested from the GPIO character device on first use,
+ * with falling edge detection so waitForInterrupt() can sleep in poll().
+ */
+
+#include <Arduino.h>
+#include <LinuxBus.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GPIO_LINES 64 //!< Highest line number + 1 that can be requested
+
+static const char *chipPath = "/dev/gpiochip0";
+static int chipFd = -1;
+static int lineFd[GPIO_LINES];
+static bool linesReady = false;
+static uint32_t syscalls = 0;
+
+/*!
+    @brief  Monotonic time since an arbitrary start.
+    @returns microseconds
+*/
+static uint64_t now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+unsigned long micros() { return now(); }
+
+unsigned long millis() { return now() / 1000; }
+
+void delay(unsigned long ms) { delayMicroseconds(ms * 1000); }
+
+void delayMicroseconds(unsigned int us) {
+  struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+  while (nanosleep(&ts, &ts) < 0 && errno == EINTR)
+    ;
+}
+
+/*!
+    @brief  Select the GPIO chip for pinMode(), digitalRead() and
+    waitForInterrupt(). Lines already requested are released.
+    @param device GPIO character device, default /dev/gpiochip0
+*/
+void setGPIOChip(const char *device) {
+  for (uint8_t i = 0; linesReady && i < GPIO_LINES; i++) {
+    if (lineFd[i] >= 0)
+      close(lineFd[i]);
+    lineFd[i] = -1;
+  }
+  if (chipFd >= 0)
+    close(chipFd);
+  chipFd = -1;
+  chipPath = device;
+}
+
+/*!
+    @brief  Request a line as input with falling edge events.
+    @param pin line offset on the GPIO chip
+    @param pullup true to enable the pull-up bias
+    @returns line file descriptor, or -1 on failure
+*/
+static int requestLine(uint8_t pin, bool pullup) {
+  struct gpio_v2_line_request req;
+
+  if (!linesReady) {
+    for (uint8_t i = 0; i < GPIO_LINES; i++)
+      lineFd[i] = -1;
+    linesReady = true;
+  }
+  if (pin >= GPIO_LINES)
+    return -1;
+  if (chipFd < 0 && (chipFd = open(chipPath, O_RDWR | O_CLOEXEC)) < 0)
+    return -1;
+  if (lineFd[pin] >= 0) {
+    close(lineFd[pin]);
+    lineFd[pin] = -1;
+  }
+
+  memset(&req, 0, sizeof(req));
+  req.offsets[0] = pin;
+  req.num_lines = 1;
+  strncpy(req.consumer, "mcp23xxx", sizeof(req.consumer) - 1);
+  req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+  if (pullup)
+    req.config.flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+  if (ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &req) < 0)
+    return -1;
+  lineFd[pin] = req.fd;
+  return req.fd;
+}
+
+/*!
+    @brief  Configure a line. Only inputs are supported, the library reads
+    the INT line and never drives host pins.
+    @param pin line offset on the GPIO chip
+    @param mode INPUT or INPUT_PULLUP
+*/
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (mode != OUTPUT)
+    requestLine(pin, mode == INPUT_PULLUP);
+}
+
+int digitalRead(uint8_t pin) {
+  struct gpio_v2_line_values values = {0, 1};
+  int fd = (linesReady && pin < GPIO_LINES) ? lineFd[pin] : -1;
+
+  if (fd < 0 && (fd = requestLine(pin, false)) < 0)
+    return LOW;
+  if (ioctl(fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+    return LOW;
+  return (values.bits & 1) ? HIGH : LOW;
+}
+
+/*!
+    @brief  Wait until an active low interrupt line is asserted, sleeping in
+    poll() until a falling edge arrives. Returns at once if the line is
+    already low, so an edge that came before the call is not missed.
+    @param pin line offset on the GPIO chip
+    @param timeoutMs time to wait in milliseconds, negative to wait forever
+    @returns 1 if the line is low, 0 on timeout, -1 on error
+*/
+int waitForInterrupt(uint8_t pin, int timeoutMs) {
+  struct gpio_v2_line_event events[16];
+  unsigned long start = millis();
+
+  if (digitalRead(pin) == LOW)
+    return 1;
+  if (!linesReady || pin >= GPIO_LINES || lineFd[pin] < 0)
+    return -1;
+
+  for (;;) {
+    int left = timeoutMs;
+    if (timeoutMs >= 0) {
+      left -= (int)(millis() - start);
+      if (left < 0)
+        left = 0;
+    }
+    struct pollfd pfd = {lineFd[pin], POLLIN, 0};
+    int ready = poll(&pfd, 1, left);
+    if (ready < 0 && errno != EINTR)
+      return -1;
+    if (ready > 0 && read(lineFd[pin], events, sizeof(events)) < 0)
+      return -1;
+    // stale edges are drained, only the current level counts
+    if (digitalRead(pin) == LOW)
+      return 1;
+    if (ready == 0)
+      return 0;
+  }
+}
+
+/*!
+    @brief  ioctl() for bus transfers, counted for benchmarks.
+    @param fd device file descriptor
+    @param request ioctl request
+    @param arg request argument
+    @returns ioctl() result
+*/
+int busIoctl(int fd, unsigned long request, void *arg) {
+  syscalls++;
+  return ioctl(fd, request, arg);
+}
+
+/*!
+    @brief  Number of bus system calls made so far.
+    @returns count of busIoctl() calls
+*/
+uint32_t busSyscalls() { return syscalls; }
@@ -0,0 +1,9 @@
+/*!
+ * @file SPI.cpp
+ *
+ * Default spidev device for the Linux build.
+ */
+
+#include <SPI.h>
+
+SPIClass SPI("/dev/spidev0.0");
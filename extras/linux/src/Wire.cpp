@@ -0,0 +1,91 @@
+/*!
+ * @file Wire.cpp
+ *
+ * i2c-dev adapter for the Linux build.
+ */
+
+#include <LinuxBus.h>
+#include <Wire.h>
+
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <unistd.h>
+
+TwoWire Wire("/dev/i2c-1");
+
+/*!
+    @brief  Name the adapter, nothing is opened yet.
+    @param device i2c-dev device path, for example /dev/i2c-1
+*/
+TwoWire::TwoWire(const char *device) : device(device) {}
+
+TwoWire::~TwoWire() { end(); }
+
+/*!
+    @brief  Open the adapter and read what transfers it supports.
+    @return true if the adapter can do plain I2C or SMBus I2C block
+    transfers, otherwise false.
+*/
+bool TwoWire::begin() {
+  if (handle >= 0)
+    return true;
+  if ((handle = open(device, O_RDWR | O_CLOEXEC)) < 0)
+    return false;
+  if (busIoctl(handle, I2C_FUNCS, &funcs) < 0 ||
+      !(funcs & (I2C_FUNC_I2C | I2C_FUNC_SMBUS_I2C_BLOCK))) {
+    end();
+    return false;
+  }
+  return true;
+}
+
+/*!
+    @brief  Close the adapter.
+*/
+void TwoWire::end() {
+  if (handle >= 0)
+    close(handle);
+  handle = -1;
+  slave = -1;
+}
+
+/*!
+    @brief  Record the bus clock. The clock of a Linux I2C adapter is set by
+    the kernel (device tree or module parameter) and cannot be changed here.
+    @param clock clock in Hz
+*/
+void TwoWire::setClock(uint32_t clock) { this->clock = clock; }
+
+/*!
+    @brief  Clock last passed to setClock().
+    @returns clock in Hz
+*/
+uint32_t TwoWire::getClock() { return clock; }
+
+/*!
+    @brief  File descriptor of the open adapter.
+    @returns file descriptor, or -1 before begin()
+*/
+int TwoWire::fd() { return handle; }
+
+/*!
+    @brief  Transfers the adapter supports, as I2C_FUNC_* bits.
+    @returns I2C_FUNCS result
+*/
+unsigned long TwoWire::functions() { return funcs; }
+
+/*!
+    @brief  Set the target address for SMBus transfers. I2C_RDWR messages
+    carry their own address and do not need this.
+    @param addr 7 bit I2C address
+    @return true if successful, otherwise false.
+*/
+bool TwoWire::select(uint8_t addr) {
+  if (slave == addr)
+    return true;
+  if (busIoctl(handle, I2C_SLAVE, (void *)(uintptr_t)addr) < 0)
+    return false;
+  slave = addr;
+  return true;
+}
@@ -0,0 +1,320 @@
+/*!
+ * @file bench.cpp
+ *
+ * Bus cost of each library call on the register simulator: transfers with
+ * the cache off and on, register bytes, and bus time at three I2C clocks.
+ */
+
+#include "sim.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23X17_Async.h>
+#include <stdio.h>
+
+#define BENCH_SAMPLES 32 //!< Samples per streaming call
+
+/*! @brief One row of the table. */
+typedef struct {
+  const char *name;                        ///< Call being measured
+  void (*prepare)(Adafruit_MCP23X17 *mcp); ///< Extra setup, or nullptr
+  void (*run)(Adafruit_MCP23X17 *mcp);     ///< Calls to measure
+} Bench;
+
+static uint8_t samples[2 * BENCH_SAMPLES];
+static uint16_t pairs[BENCH_SAMPLES];
+static MCP23XXX_Run runs[4];
+static MCP23XXX_Registers regs;
+static uint8_t portRegs[MCP23XXX_OLAT + 1];
+
+static void onRead(bool ok, uint16_t value) {
+  (void)ok;
+  (void)value;
+}
+
+static void toBank1(Adafruit_MCP23X17 *mcp) { mcp->setRegisterBank(1); }
+
+static void begin(Adafruit_MCP23X17 *mcp) { mcp->begin_I2C(); }
+
+// pin 1 starts as an output, so both calls change the direction
+static void pinMode(Adafruit_MCP23X17 *mcp) {
+  mcp->pinMode(1, INPUT);
+  mcp->pinMode(1, OUTPUT);
+}
+
+static void digitalRead(Adafruit_MCP23X17 *mcp) { mcp->digitalRead(8); }
+
+static void digitalWrite(Adafruit_MCP23X17 *mcp) {
+  mcp->digitalWrite(0, HIGH);
+}
+
+static void readGPIO(Adafruit_MCP23X17 *mcp) { mcp->readGPIO(1); }
+
+static void writeGPIO(Adafruit_MCP23X17 *mcp) { mcp->writeGPIO(0x0F, 0); }
+
+static void readGPIOA(Adafruit_MCP23X17 *mcp) { mcp->readGPIOA(); }
+
+static void writeGPIOA(Adafruit_MCP23X17 *mcp) { mcp->writeGPIOA(0x0F); }
+
+static void readGPIOB(Adafruit_MCP23X17 *mcp) { mcp->readGPIOB(); }
+
+static void writeGPIOB(Adafruit_MCP23X17 *mcp) { mcp->writeGPIOB(0x0F); }
+
+static void readGPIOAB(Adafruit_MCP23X17 *mcp) { mcp->readGPIOAB(); }
+
+static void writeGPIOAB(Adafruit_MCP23X17 *mcp) { mcp->writeGPIOAB(0x00FF); }
+
+static void pinModeMask(Adafruit_MCP23X17 *mcp) {
+  mcp->pinModeMask(0x0F0F, INPUT_PULLUP);
+}
+
+static void digitalWriteMask(Adafruit_MCP23X17 *mcp) {
+  mcp->digitalWriteMask(0x00F0, 0x0050);
+}
+
+static void batch(Adafruit_MCP23X17 *mcp) {
+  mcp->beginBatch();
+  for (uint8_t pin = 0; pin < 8; pin++)
+    mcp->digitalWrite(pin, pin & 1);
+  mcp->commit();
+}
+
+static void configure(Adafruit_MCP23X17 *mcp) {
+  MCP23XXX_PortConfig config = {0xFF00, 0, 0xFF00, 0, 0, 0xFF00, 0x00AA};
+  mcp->configure(config);
+}
+
+static void configureVerify(Adafruit_MCP23X17 *mcp) {
+  MCP23XXX_PortConfig config = {0xFF00, 0, 0xFF00, 0, 0, 0xFF00, 0x00AA};
+  mcp->configure(config, true);
+}
+
+static void setupInterrupts(Adafruit_MCP23X17 *mcp) {
+  mcp->setupInterrupts(true, false, LOW);
+}
+
+static void setupInterruptPin(Adafruit_MCP23X17 *mcp) {
+  mcp->setupInterruptPin(9, LOW);
+}
+
+static void disableInterruptPin(Adafruit_MCP23X17 *mcp) {
+  mcp->disableInterruptPin(8);
+}
+
+static void getInterruptEnabled(Adafruit_MCP23X17 *mcp) {
+  mcp->getInterruptEnabled();
+}
+
+static void interruptPending(Adafruit_MCP23X17 *mcp) {
+  (void)mcp;
+  simChips[0].setInputs(0x0100);
+}
+
+static void clearInterrupts(Adafruit_MCP23X17 *mcp) {
+  mcp->clearInterrupts();
+}
+
+static void getLastInterruptPin(Adafruit_MCP23X17 *mcp) {
+  mcp->getLastInterruptPin();
+}
+
+static void getCapturedInterrupt(Adafruit_MCP23X17 *mcp) {
+  mcp->getCapturedInterrupt();
+}
+
+static void serviceInterrupt(Adafruit_MCP23X17 *mcp) {
+  mcp->serviceInterrupt(true);
+}
+
+static void serviceInterruptStatus(Adafruit_MCP23X17 *mcp) {
+  MCP23XXX_Interrupt irq;
+  mcp->serviceInterrupt(&irq);
+}
+
+static void readAllRegisters(Adafruit_MCP23X17 *mcp) {
+  mcp->readAllRegisters(&regs);
+}
+
+static void writeAllRegisters(Adafruit_MCP23X17 *mcp) {
+  mcp->readAllRegisters(&regs);
+  mcp->writeAllRegisters(&regs);
+}
+
+static void readPortRegisters(Adafruit_MCP23X17 *mcp) {
+  mcp->readPortRegisters(portRegs, 1);
+}
+
+static void writePortRegisters(Adafruit_MCP23X17 *mcp) {
+  mcp->readPortRegisters(portRegs, 1);
+  mcp->writePortRegisters(portRegs, 1);
+}
+
+static void setRegisterBank(Adafruit_MCP23X17 *mcp) {
+  mcp->setRegisterBank(1);
+  mcp->setRegisterBank(0);
+}
+
+static void getRegisterBank(Adafruit_MCP23X17 *mcp) {
+  mcp->getRegisterBank();
+}
+
+static void enableAddrPins(Adafruit_MCP23X17 *mcp) { mcp->enableAddrPins(); }
+
+static void setBusClock(Adafruit_MCP23X17 *mcp) {
+  mcp->setBusClock(Wire.getClock());
+}
+
+static void getBusClock(Adafruit_MCP23X17 *mcp) { mcp->getBusClock(); }
+
+static void autoTuneClock(Adafruit_MCP23X17 *mcp) {
+  const uint32_t freqs[] = {100000, 400000};
+  mcp->autoTuneClock(freqs, 2);
+}
+
+static void enableCache(Adafruit_MCP23X17 *mcp) { mcp->enableCache(); }
+
+static void refreshCache(Adafruit_MCP23X17 *mcp) { mcp->refreshCache(); }
+
+static void writeGPIOStream(Adafruit_MCP23X17 *mcp) {
+  mcp->writeGPIOStream(samples, BENCH_SAMPLES);
+}
+
+static void readGPIOStream(Adafruit_MCP23X17 *mcp) {
+  mcp->readGPIOStream(samples, BENCH_SAMPLES, 1);
+}
+
+static void writeGPIOABStream(Adafruit_MCP23X17 *mcp) {
+  mcp->writeGPIOABStream(pairs, BENCH_SAMPLES);
+}
+
+static void readGPIOABStream(Adafruit_MCP23X17 *mcp) {
+  mcp->readGPIOABStream(pairs, BENCH_SAMPLES);
+}
+
+static void readGPIOChanges(Adafruit_MCP23X17 *mcp) {
+  mcp->readGPIOChanges(runs, 4, BENCH_SAMPLES);
+}
+
+static void asyncReadWrite(Adafruit_MCP23X17 *mcp) {
+  Adafruit_MCP23X17_Async async(mcp);
+  async.readGPIOABAsync(onRead);
+  async.writeGPIOABAsync(0x0055);
+  async.writeGPIOABAsync(0x00AA);
+  while (async.poll())
+    ;
+}
+
+static const Bench benches[] = {
+    {"begin_I2C", nullptr, begin},
+    {"pinMode in, out", nullptr, pinMode},
+    {"digitalRead", nullptr, digitalRead},
+    {"digitalWrite", nullptr, digitalWrite},
+    {"readGPIO", nullptr, readGPIO},
+    {"writeGPIO", nullptr, writeGPIO},
+    {"readGPIOA", nullptr, readGPIOA},
+    {"writeGPIOA", nullptr, writeGPIOA},
+    {"readGPIOB", nullptr, readGPIOB},
+    {"writeGPIOB", nullptr, writeGPIOB},
+    {"readGPIOAB", nullptr, readGPIOAB},
+    {"writeGPIOAB", nullptr, writeGPIOAB},
+    {"pinModeMask", nullptr, pinModeMask},
+    {"digitalWriteMask", nullptr, digitalWriteMask},
+    {"batch of 8 writes", nullptr, batch},
+    {"configure", nullptr, configure},
+    {"configure, verify", nullptr, configureVerify},
+    {"setupInterrupts", nullptr, setupInterrupts},
+    {"setupInterruptPin", nullptr, setupInterruptPin},
+    {"disableInterruptPin", nullptr, disableInterruptPin},
+    {"getInterruptEnabled", nullptr, getInterruptEnabled},
+    {"clearInterrupts", interruptPending, clearInterrupts},
+    {"getLastInterruptPin", interruptPending, getLastInterruptPin},
+    {"getCapturedInterrupt", interruptPending, getCapturedInterrupt},
+    {"serviceInterrupt", interruptPending, serviceInterrupt},
+    {"serviceInterrupt(irq)", interruptPending, serviceInterruptStatus},
+    {"readAllRegisters", nullptr, readAllRegisters},
+    {"read+writeAllRegisters", nullptr, writeAllRegisters},
+    {"readPortRegisters", nullptr, readPortRegisters},
+    {"readPortRegisters BANK1", toBank1, readPortRegisters},
+    {"read+writePortRegisters", nullptr, writePortRegisters},
+    {"read+writePort.. BANK1", toBank1, writePortRegisters},
+    {"setRegisterBank 1, 0", nullptr, setRegisterBank},
+    {"getRegisterBank", nullptr, getRegisterBank},
+    {"enableAddrPins (I2C)", nullptr, enableAddrPins},
+    {"setBusClock", nullptr, setBusClock},
+    {"getBusClock", nullptr, getBusClock},
+    {"autoTuneClock 2 clocks", setBusClock, autoTuneClock},
+    {"enableCache", nullptr, enableCache},
+    {"refreshCache", nullptr, refreshCache},
+    {"writeGPIOStream x32", nullptr, writeGPIOStream},
+    {"readGPIOStream x32", nullptr, readGPIOStream},
+    {"writeGPIOABStream x32", nullptr, writeGPIOABStream},
+    {"readGPIOABStream x32", nullptr, readGPIOABStream},
+    {"readGPIOChanges x32", nullptr, readGPIOChanges},
+    {"readGPIOChanges BANK1", toBank1, readGPIOChanges},
+    {"async read, 2 writes", nullptr, asyncReadWrite},
+};
+
+/*! @brief Bus cost of one call. */
+typedef struct {
+  uint32_t transactions; ///< Transfers
+  uint32_t bytes;        ///< Register bytes
+  uint32_t micros;       ///< Simulated time
+} Cost;
+
+/*!
+    @brief  Measure one table row on a freshly started chip.
+    @param bench row to measure
+    @param cache true to enable the register cache
+    @param clock I2C clock in Hz
+    @returns bus cost of the measured calls
+*/
+static Cost measure(const Bench &bench, bool cache, uint32_t clock) {
+  Adafruit_MCP23X17 mcp;
+  Cost cost = {0, 0, 0};
+
+  simReset();
+  Wire.setClock(clock);
+  mcp.enableCache(cache);
+  mcp.begin_I2C();
+  // Port A outputs, Port B inputs with interrupts
+  mcp.pinModeMask(0x00FF, OUTPUT);
+  mcp.pinModeMask(0xFF00, INPUT_PULLUP);
+  mcp.setupInterruptPin(8, CHANGE);
+  if (bench.prepare)
+    bench.prepare(&mcp);
+
+  uint32_t start = simTime();
+  for (uint8_t i = 0; i < SIM_CHIPS; i++) {
+    cost.transactions -= simChips[i].transactions;
+    cost.bytes -= simChips[i].bytes;
+  }
+  bench.run(&mcp);
+  for (uint8_t i = 0; i < SIM_CHIPS; i++) {
+    cost.transactions += simChips[i].transactions;
+    cost.bytes += simChips[i].bytes;
+  }
+  cost.micros = simTime() - start;
+  return cost;
+}
+
+int main() {
+  const uint32_t clocks[] = {100000, 400000, 1700000};
+
+  printf("%-24s %9s %9s %6s %9s %9s %9s\n", "call", "xfers", "cached",
+         "bytes", "us@100k", "us@400k", "us@1.7M");
+  for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+    Cost uncached = measure(benches[i], false, clocks[0]);
+    Cost cached = measure(benches[i], true, clocks[0]);
+
+    printf("%-24s %9lu %9lu %6lu", benches[i].name,
+           (unsigned long)uncached.transactions,
+           (unsigned long)cached.transactions, (unsigned long)cached.bytes);
+    for (uint8_t c = 0; c < 3; c++) {
+      Cost timed = measure(benches[i], true, clocks[c]);
+      printf(" %9lu", (unsigned long)timed.micros);
+    }
+    printf("\n");
+  }
+  printf("sizeof(Adafruit_MCP23X17) %lu\n",
+         (unsigned long)sizeof(Adafruit_MCP23X17));
+  return 0;
+}
@@ -0,0 +1,434 @@
+/*!
+ * @file sim.cpp
+ *
+ * Register simulator, and the host Arduino and BusIO functions that use it.
+ * Simulated time advances by the bus time of each transfer.
+ */
+
+#include "sim.h"
+
+#include <Adafruit_BusIO_Register.h>
+#include <Adafruit_MCP23X17.h>
+
+SimChip simChips[SIM_CHIPS];
+TwoWire Wire;
+SPIClass SPI;
+
+static uint32_t now = 0;
+
+/*!
+    @brief  Advance simulated time by a bus transfer.
+    @param bits number of bit times on the bus
+    @param clock bus clock in Hz
+*/
+static void busTime(uint32_t bits, uint32_t clock) {
+  now += (uint64_t)bits * 1000000UL / clock;
+}
+
+/*!
+    @brief  Reset all chips to their power-on state.
+    @param x17 true for MCP23017, false for MCP23008
+*/
+void simReset(bool x17) {
+  for (uint8_t i = 0; i < SIM_CHIPS; i++)
+    simChips[i].reset(x17);
+  Wire.setClock(100000);
+}
+
+/*!
+    @brief  Reset the simulator and start an MCP23017 at the first address.
+    @param mcp chip to start
+    @param cache true to enable the register cache
+    @return true if successful
+*/
+bool simStart(Adafruit_MCP23X17 *mcp, bool cache) {
+  simReset();
+  mcp->enableCache(cache);
+  return mcp->begin_I2C();
+}
+
+/*!
+    @brief  Transfers to all chips since the last reset.
+    @returns number of transfers
+*/
+uint32_t simTransactions() {
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < SIM_CHIPS; i++)
+    total += simChips[i].transactions;
+  return total;
+}
+
+/*!
+    @brief  Simulated time.
+    @returns microseconds
+*/
+uint32_t simTime() { return now; }
+
+/*!
+    @brief  Power-on reset.
+    @param x17 true for MCP23017, false for MCP23008
+*/
+void SimChip::reset(bool x17) {
+  this->x17 = x17;
+  memset(regs, 0, sizeof(regs));
+  regs[0][MCP23XXX_IODIR] = regs[1][MCP23XXX_IODIR] = 0xFF;
+  inputs = 0;
+  previous[0] = previous[1] = 0;
+  transactions = 0;
+  bytes = 0;
+  failures = 0;
+  drivenHigh = 0;
+  wiring = nullptr;
+}
+
+/*!
+    @brief  Drive the input pins, which may raise an interrupt.
+    @param levels pin levels, bit 0 is pin 0
+*/
+void SimChip::setInputs(uint16_t levels) {
+  inputs = levels;
+  evaluate();
+}
+
+/*!
+    @brief  Levels driven by the output pins.
+    @returns output latch of pins configured as outputs, bit 0 is pin 0
+*/
+uint16_t SimChip::getOutputs() {
+  uint8_t a = regs[0][MCP23XXX_OLAT] & ~regs[0][MCP23XXX_IODIR];
+  uint8_t b = regs[1][MCP23XXX_OLAT] & ~regs[1][MCP23XXX_IODIR];
+
+  return a | ((uint16_t)b << 8);
+}
+
+/*!
+    @brief  Register value, whatever the register layout.
+    @param base register, as for BANK=0
+    @param port 0 for Port A, 1 for Port B
+    @returns register value
+*/
+uint8_t SimChip::get(uint8_t base, uint8_t port) {
+  if (base == MCP23XXX_GPIO)
+    return gpio(port);
+  return regs[port][base];
+}
+
+/*!
+    @brief  Set a register without a bus transfer.
+    @param base register, as for BANK=0
+    @param value new value
+    @param port 0 for Port A, 1 for Port B
+*/
+void SimChip::set(uint8_t base, uint8_t value, uint8_t port) {
+  if (base == MCP23XXX_IOCON)
+    regs[0][base] = regs[1][base] = value;
+  else
+    regs[port][base] = value;
+}
+
+/*!
+    @brief  State of the INT output, both ports mirrored.
+    @returns true if an interrupt is pending
+*/
+bool SimChip::intActive() {
+  return regs[0][MCP23XXX_INTF] || regs[1][MCP23XXX_INTF];
+}
+
+/*!
+    @brief  One bus transfer: write registers starting at address, then
+    read on from where the address pointer ended up.
+    @param address register address on the bus
+    @param out values to write
+    @param outLen number of values to write
+    @param in buffer for values read
+    @param inLen number of values to read
+    @return false if the transfer was set up to fail
+*/
+bool SimChip::transfer(uint8_t address, const uint8_t *out, size_t outLen,
+                       uint8_t *in, size_t inLen) {
+  transactions++;
+  if (failures) {
+    failures--;
+    return false;
+  }
+
+  for (size_t i = 0; i < outLen; i++) {
+    writeByte(address, out[i]);
+    address = next(address);
+  }
+  if (wiring)
+    wiring(this);
+  for (size_t i = 0; i < inLen; i++) {
+    in[i] = readByte(address);
+    address = next(address);
+  }
+  bytes += outLen + inLen;
+  evaluate();
+
+  return true;
+}
+
+/*!
+    @brief  Check the register layout.
+    @returns true for MCP23017 with IOCON.BANK = 1
+*/
+bool SimChip::bank() { return x17 && (regs[0][MCP23XXX_IOCON] & (1 << 7)); }
+
+/*!
+    @brief  Find the register at a bus address.
+    @param address register address on the bus
+    @param base set to register, as for BANK=0
+    @param port set to 0 for Port A, 1 for Port B
+*/
+void SimChip::decode(uint8_t address, uint8_t *base, uint8_t *port) {
+  if (!x17) {
+    *base = address;
+    *port = 0;
+  } else if (bank()) {
+    *base = address & 0x0F;
+    *port = (address >> 4) & 1;
+  } else {
+    *base = address >> 1;
+    *port = address & 1;
+  }
+}
+
+/*!
+    @brief  Move the address pointer after a byte.
+    @param address current register address
+    @returns next register address
+*/
+uint8_t SimChip::next(uint8_t address) {
+  bool sequential = !(regs[0][MCP23XXX_IOCON] & (1 << 5));
+
+  if (!x17)
+    return sequential ? (address + 1) % (MCP23XXX_OLAT + 1) : address;
+  if (bank()) {
+    if (!sequential)
+      return address;
+    if ((address & 0x0F) == MCP23XXX_OLAT)
+      return (address & 0x10) ? 0x00 : 0x10;
+    return address + 1;
+  }
+  // BANK=0 byte mode toggles between the A and B registers of a pair
+  return sequential ? (address + 1) % (2 * (MCP23XXX_OLAT + 1)) : address ^ 1;
+}
+
+/*!
+    @brief  Port pin levels as read from GPIO.
+    @param port 0 for Port A, 1 for Port B
+    @returns input levels, inverted by IPOL, and output latches
+*/
+uint8_t SimChip::gpio(uint8_t port) {
+  uint8_t *r = regs[port];
+  uint8_t levels = ((inputs >> (8 * port)) ^ r[MCP23XXX_IPOL]);
+
+  return (levels & r[MCP23XXX_IODIR]) |
+         (r[MCP23XXX_OLAT] & ~r[MCP23XXX_IODIR]);
+}
+
+/*!
+    @brief  Read one register over the bus.
+    @param address register address on the bus
+    @returns register value
+*/
+uint8_t SimChip::readByte(uint8_t address) {
+  uint8_t base, port;
+
+  decode(address, &base, &port);
+  if (base > MCP23XXX_OLAT)
+    return 0;
+  // reading GPIO or INTCAP clears the interrupt
+  if (base == MCP23XXX_GPIO || base == MCP23XXX_INTCAP) {
+    uint8_t value = (base == MCP23XXX_GPIO) ? gpio(port) : regs[port][base];
+    regs[port][MCP23XXX_INTF] = 0;
+    return value;
+  }
+  return regs[port][base];
+}
+
+/*!
+    @brief  Write one register over the bus.
+    @param address register address on the bus
+    @param value value to write
+*/
+void SimChip::writeByte(uint8_t address, uint8_t value) {
+  uint8_t base, port;
+
+  decode(address, &base, &port);
+  switch (base) {
+  case MCP23XXX_IOCON:
+    // shared by both ports, no BANK bit on MCP23008
+    set(MCP23XXX_IOCON, x17 ? value : (value & ~(1 << 7)));
+    break;
+  case MCP23XXX_INTF:
+  case MCP23XXX_INTCAP:
+    // read-only
+    break;
+  case MCP23XXX_GPIO:
+    regs[port][MCP23XXX_OLAT] = value;
+    break;
+  default:
+    if (base <= MCP23XXX_OLAT)
+      regs[port][base] = value;
+    break;
+  }
+  drivenHigh |= getOutputs();
+}
+
+/*!
+    @brief  Raise interrupts for pins that changed, or differ from DEFVAL.
+*/
+void SimChip::evaluate() {
+  for (uint8_t port = 0; port < (x17 ? 2 : 1); port++) {
+    uint8_t *r = regs[port];
+    uint8_t levels = gpio(port);
+    uint8_t changed = levels ^ previous[port];
+    uint8_t differs = levels ^ r[MCP23XXX_DEFVAL];
+    uint8_t trigger = (changed & ~r[MCP23XXX_INTCON]) |
+                      (differs & r[MCP23XXX_INTCON]);
+
+    previous[port] = levels;
+    trigger &= r[MCP23XXX_GPINTEN];
+    if (trigger && !r[MCP23XXX_INTF]) {
+      r[MCP23XXX_INTF] = trigger;
+      r[MCP23XXX_INTCAP] = levels;
+    }
+  }
+}
+
+unsigned long micros() { return now++; }
+
+unsigned long millis() { return now / 1000; }
+
+void delay(unsigned long ms) { now += ms * 1000; }
+
+int digitalRead(uint8_t pin) {
+  if (pin != SIM_INT_PIN)
+    return LOW;
+  // open drain, active LOW outputs wired together
+  for (uint8_t i = 0; i < SIM_CHIPS; i++) {
+    if (simChips[i].intActive())
+      return LOW;
+  }
+  return HIGH;
+}
+
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire) {
+  this->addr = addr;
+  wire = theWire;
+}
+
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  (void)addr_detect;
+  return (addr >= MCP23XXX_ADDR) && (addr < MCP23XXX_ADDR + SIM_CHIPS);
+}
+
+bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len, uint8_t *read_buffer,
+                                         size_t read_len, bool stop) {
+  (void)stop;
+  if (!write_len || !begin())
+    return false;
+
+  // address, register and data bytes, then address and data bytes
+  busTime(9 * (1 + write_len + (read_len ? 1 + read_len : 0)),
+          wire->getClock());
+  return simChips[addr - MCP23XXX_ADDR].transfer(
+      write_buffer[0], write_buffer + 1, write_len - 1, read_buffer, read_len);
+}
+
+bool Adafruit_I2CDevice::setSpeed(uint32_t desiredclk) {
+  wire->setClock(desiredclk);
+  return true;
+}
+
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode, SPIClass *theSPI) {
+  (void)cspin;
+  (void)dataOrder;
+  (void)dataMode;
+  (void)theSPI;
+  this->freq = freq;
+}
+
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso,
+                                       int8_t mosi, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode) {
+  (void)cspin;
+  (void)sck;
+  (void)miso;
+  (void)mosi;
+  (void)dataOrder;
+  (void)dataMode;
+  this->freq = freq;
+}
+
+/*!
+    @brief  SPI transfer to the chips selected by the opcode. An MCP23S17
+    decodes its full hardware address only once IOCON.HAEN is set. Before
+    that it should answer address 0, but it still compares A2, so it answers
+    every address with its own A2 bit (0b0xx or 0b1xx).
+    @param spi SPI device
+    @param addr opcode in the high byte, register in the low byte
+    @param out values to write
+    @param outLen number of values to write
+    @param in buffer for values read
+    @param inLen number of values to read
+    @return true if successful
+*/
+static bool spiTransfer(Adafruit_SPIDevice *spi, uint16_t addr,
+                        const uint8_t *out, size_t outLen, uint8_t *in,
+                        size_t inLen) {
+  uint8_t hw = (addr >> 9) & 0x07;
+  uint8_t ignored[255];
+  bool ok = true;
+  bool answered = false;
+
+  busTime(8 * (2 + outLen + inLen), spi->speed());
+  for (uint8_t i = 0; i < SIM_CHIPS; i++) {
+    bool haen = simChips[i].get(MCP23XXX_IOCON) & (1 << 3);
+
+    if (haen ? (i != hw) : ((i & 0x04) != (hw & 0x04)))
+      continue;
+    // MISO is read from the first chip that answers
+    ok &= simChips[i].transfer(addr & 0xFF, out, outLen,
+                               answered ? ignored : in, inLen);
+    answered = true;
+  }
+  return ok;
+}
+
+Adafruit_BusIO_Register::Adafruit_BusIO_Register(
+    Adafruit_I2CDevice *i2cdevice, Adafruit_SPIDevice *spidevice,
+    Adafruit_BusIO_SPIRegType type, uint16_t reg_addr, uint8_t width,
+    uint8_t byteorder, uint8_t address_width) {
+  (void)type;
+  (void)width;
+  (void)byteorder;
+  (void)address_width;
+  i2c = i2cdevice;
+  spi = spidevice;
+  addr = reg_addr;
+}
+
+bool Adafruit_BusIO_Register::read(uint8_t *buffer, uint8_t len) {
+  uint8_t reg = addr & 0xFF;
+
+  if (i2c)
+    return i2c->write_then_read(&reg, 1, buffer, len);
+  return spiTransfer(spi, addr, nullptr, 0, buffer, len);
+}
+
+bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  uint8_t cmd[1 + 255];
+
+  if (!i2c)
+    return spiTransfer(spi, addr, buffer, len, nullptr, 0);
+  cmd[0] = addr & 0xFF;
+  memcpy(cmd + 1, buffer, len);
+  return i2c->write_then_read(cmd, 1 + len, nullptr, 0);
+}
@@ -0,0 +1,67 @@
+/*!
+ * @file sim.h
+ *
+ * Register level simulator of the MCP23008/17 for host tests. It models
+ * the BANK=0 and BANK=1 register layouts, sequential and byte addressing,
+ * output latches, input polarity, interrupt-on-change with INTF and
+ * INTCAP, and the SPI address decoding of IOCON.HAEN. Every bus transfer is
+ * counted.
+ */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include <Arduino.h>
+
+#define SIM_CHIPS 8   //!< Chips at I2C address 0x20 + i or SPI address i
+#define SIM_INT_PIN 2 //!< Host pin wired to the INT outputs of all chips
+
+/*!
+    @brief  One simulated MCP23008 or MCP23017.
+*/
+class SimChip {
+public:
+  void reset(bool x17 = true);
+
+  void setInputs(uint16_t levels);
+  uint16_t getOutputs();
+  uint8_t get(uint8_t base, uint8_t port = 0);
+  void set(uint8_t base, uint8_t value, uint8_t port = 0);
+  bool intActive();
+
+  bool transfer(uint8_t address, const uint8_t *out, size_t outLen,
+                uint8_t *in, size_t inLen);
+
+  uint32_t transactions = 0; ///< Bus transfers addressed to this chip
+  uint32_t bytes = 0;        ///< Register bytes transferred
+  uint8_t failures = 0;      ///< Number of following transfers to fail
+  uint16_t drivenHigh = 0;   ///< Output pins that were ever driven HIGH
+
+  /*! @brief Called before each transfer, to model external circuits. */
+  void (*wiring)(SimChip *chip) = nullptr;
+
+private:
+  bool x17 = true;
+  uint8_t regs[2][11] = {};
+  uint16_t inputs = 0;
+  uint8_t previous[2] = {0, 0};
+
+  bool bank();
+  void decode(uint8_t address, uint8_t *base, uint8_t *port);
+  uint8_t next(uint8_t address);
+  uint8_t gpio(uint8_t port);
+  uint8_t readByte(uint8_t address);
+  void writeByte(uint8_t address, uint8_t value);
+  void evaluate();
+};
+
+class Adafruit_MCP23X17;
+
+extern SimChip simChips[SIM_CHIPS];
+
+void simReset(bool x17 = true);
+bool simStart(Adafruit_MCP23X17 *mcp, bool cache = false);
+uint32_t simTransactions();
+uint32_t simTime();
+
+#endif
@@ -0,0 +1,31 @@
+/*!
+ * @file Adafruit_I2CDevice.h
+ *
+ * Host stand-in for the Adafruit BusIO I2C device, connected to the
+ * register simulator. Only the calls used by this library are provided.
+ */
+
+#ifndef __HOST_ADAFRUIT_I2CDEVICE_H__
+#define __HOST_ADAFRUIT_I2CDEVICE_H__
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire);
+
+  uint8_t address(void) { return addr; }
+  bool begin(bool addr_detect = true);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false);
+  bool setSpeed(uint32_t desiredclk);
+  size_t maxBufferSize() { return 32; }
+
+private:
+  uint8_t addr;
+  TwoWire *wire;
+};
+
+#endif
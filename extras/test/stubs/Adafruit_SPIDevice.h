@@ -0,0 +1,37 @@
+/*!
+ * @file Adafruit_SPIDevice.h
+ *
+ * Host stand-in for the Adafruit BusIO SPI device. Transfers are handled by
+ * the Adafruit_BusIO_Register stub.
+ */
+
+#ifndef __HOST_ADAFRUIT_SPIDEVICE_H__
+#define __HOST_ADAFRUIT_SPIDEVICE_H__
+
+#include <Arduino.h>
+#include <SPI.h>
+
+typedef enum {
+  SPI_BITORDER_MSBFIRST = MSBFIRST,
+  SPI_BITORDER_LSBFIRST = LSBFIRST,
+} BusIOBitOrder;
+
+class Adafruit_SPIDevice {
+public:
+  Adafruit_SPIDevice(int8_t cspin, uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0, SPIClass *theSPI = &SPI);
+  Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso, int8_t mosi,
+                     uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0);
+  ~Adafruit_SPIDevice() {}
+
+  bool begin(void) { return true; }
+  uint32_t speed() { return freq; }
+
+private:
+  uint32_t freq;
+};
+
+#endif
@@ -0,0 +1,34 @@
+/*!
+ * @file Arduino.h
+ *
+ * Minimal Arduino API for building the library on a host computer. Time
+ * and the INT line come from the register simulator, see sim.h.
+ */
+
+#ifndef __HOST_ARDUINO_H__
+#define __HOST_ARDUINO_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+int digitalRead(uint8_t pin);
+
+#endif
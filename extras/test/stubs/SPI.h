@@ -0,0 +1,19 @@
+/*!
+ * @file SPI.h
+ *
+ * Host stand-in for the Arduino SPI library. Transfers are handled by the
+ * Adafruit_SPIDevice stub.
+ */
+
+#ifndef __HOST_SPI_H__
+#define __HOST_SPI_H__
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+
+class SPIClass {};
+
+extern SPIClass SPI;
+
+#endif
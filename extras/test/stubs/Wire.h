@@ -0,0 +1,24 @@
+/*!
+ * @file Wire.h
+ *
+ * Host stand-in for the Arduino Wire library. Transfers are handled by the
+ * Adafruit_I2CDevice stub, which times them at the clock set here.
+ */
+
+#ifndef __HOST_WIRE_H__
+#define __HOST_WIRE_H__
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  void setClock(uint32_t clock) { this->clock = clock; }
+  uint32_t getClock() { return clock; }
+
+private:
+  uint32_t clock = 100000;
+};
+
+extern TwoWire Wire;
+
+#endif
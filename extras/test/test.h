@@ -0,0 +1,51 @@
+/*!
+ * @file test.h
+ *
+ * Minimal test framework for the host tests.
+ */
+
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <stdio.h>
+
+/*!
+    @brief  A test, registered by the TEST() macro.
+*/
+struct TestCase {
+  TestCase(const char *name, void (*run)());
+
+  const char *name; ///< Test name
+  void (*run)();    ///< Test function
+  TestCase *next;   ///< Next registered test
+};
+
+extern int testFailures;
+
+/*! @brief Define and register a test. */
+#define TEST(name)                                                             \
+  static void name();                                                          \
+  static TestCase name##_case(#name, name);                                    \
+  static void name()
+
+/*! @brief Report a failed check, but keep running the test. */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      testFailures++;                                                          \
+    }                                                                          \
+  } while (0)
+
+/*! @brief Check two integer values are equal, printing both if not. */
+#define CHECK_EQ(actual, expected)                                             \
+  do {                                                                         \
+    long a_ = (long)(actual), e_ = (long)(expected);                           \
+    if (a_ != e_) {                                                            \
+      printf("%s:%d: CHECK_EQ(%s, %s) failed: %ld != %ld\n", __FILE__,         \
+             __LINE__, #actual, #expected, a_, e_);                            \
+      testFailures++;                                                          \
+    }                                                                          \
+  } while (0)
+
+#endif
@@ -0,0 +1,101 @@
+/*!
+ * @file test_async.cpp
+ *
+ * Host tests of the queued asynchronous transfers.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23X17_Async.h>
+
+static uint16_t reads[4];
+static uint8_t readCount;
+static uint16_t intFlags;
+static uint8_t intFailures;
+
+static void onRead(bool ok, uint16_t value) {
+  if (ok && readCount < 4)
+    reads[readCount++] = value;
+}
+
+static void onInterrupt(bool ok, uint16_t flags, uint16_t captured) {
+  (void)captured;
+  if (!ok)
+    intFailures++;
+  intFlags = flags;
+}
+
+TEST(async_transfers) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23X17_Async async(&mcp);
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0x00FF, OUTPUT);
+  mcp.setupInterruptPin(8, CHANGE);
+  readCount = 0;
+  intFlags = 0;
+
+  // nothing touches the bus until poll()
+  uint32_t before = simTransactions();
+  CHECK(async.writeGPIOABAsync(0x0055));
+  CHECK(async.serviceInterruptAsync(onInterrupt));
+  CHECK(async.readGPIOABAsync(onRead));
+  CHECK_EQ(async.pending(), 3);
+  CHECK_EQ(simTransactions() - before, 0);
+
+  simChips[0].setInputs(0x0100);
+  while (async.poll())
+    ;
+  CHECK_EQ(simTransactions() - before, 3);
+  CHECK_EQ(readCount, 1);
+  CHECK_EQ(reads[0], 0x0155);
+  CHECK_EQ(intFlags, 0x0100);
+  CHECK(!async.poll());
+}
+
+TEST(async_keeps_order) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23X17_Async async(&mcp);
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  readCount = 0;
+
+  CHECK(async.writeGPIOABAsync(0x0001));
+  CHECK(async.readGPIOABAsync(onRead));
+  CHECK(async.writeGPIOABAsync(0x0002));
+  CHECK(async.writeGPIOABAsync(0x0003)); // merges with the tail
+  CHECK(async.readGPIOABAsync(onRead));
+  CHECK_EQ(async.pending(), 4);
+
+  uint32_t before = simTransactions();
+  while (async.poll())
+    ;
+  CHECK_EQ(simTransactions() - before, 4);
+  CHECK_EQ(readCount, 2);
+  CHECK_EQ(reads[0], 0x0001);
+  CHECK_EQ(reads[1], 0x0003);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0003);
+}
+
+TEST(async_interrupt_read_fails) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23X17_Async async(&mcp);
+  CHECK(simStart(&mcp));
+  mcp.setupInterruptPin(8, CHANGE);
+  intFlags = 0xFFFF;
+  intFailures = 0;
+
+  simChips[0].setInputs(0x0100);
+  simChips[0].failures = 1;
+  CHECK(async.serviceInterruptAsync(onInterrupt));
+  CHECK(async.poll());
+  CHECK_EQ(intFailures, 1);
+  CHECK_EQ(intFlags, 0);
+
+  // the interrupt is still pending for the next attempt
+  CHECK(async.serviceInterruptAsync(onInterrupt));
+  CHECK(async.poll());
+  CHECK_EQ(intFailures, 1);
+  CHECK_EQ(intFlags, 0x0100);
+}
@@ -0,0 +1,68 @@
+/*!
+ * @file test_bank.cpp
+ *
+ * Host tests of the multi chip bank.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17_Bank.h>
+
+TEST(bank_virtual_pins) {
+  Adafruit_MCP23X17_Bank<2> bank;
+  simReset();
+  CHECK(bank.begin_I2C());
+  CHECK_EQ(bank.pinCount(), 32);
+  bank.pinMode(0, OUTPUT);
+  bank.pinMode(16, OUTPUT);
+  bank.pinMode(31, INPUT);
+  bank.flush();
+
+  // only chips with changed outputs are written
+  uint32_t before = simChips[1].transactions;
+  bank.setPin(0, HIGH);
+  bank.flush();
+  CHECK_EQ(simChips[0].getOutputs(), 0x0001);
+  CHECK_EQ(simChips[1].transactions, before);
+
+  bank.digitalWrite(16, HIGH);
+  CHECK_EQ(simChips[1].getOutputs(), 0x0001);
+  simChips[1].setInputs(0x8000);
+  CHECK_EQ(bank.digitalRead(31), HIGH);
+  CHECK_EQ(bank.digitalRead(15), LOW);
+}
+
+TEST(bank_loads_outputs) {
+  Adafruit_MCP23X17_Bank<2> bank;
+  simReset();
+  simChips[0].set(MCP23XXX_OLAT, 0xF0, 0);
+  simChips[1].set(MCP23XXX_OLAT, 0x0F, 1);
+  CHECK(bank.begin_I2C());
+  bank.pinMode(0, OUTPUT);
+
+  uint32_t before = simChips[1].transactions;
+  bank.setPin(0, HIGH);
+  bank.flush();
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 0), 0xF1);
+  CHECK_EQ(simChips[1].transactions, before);
+  bank.digitalWrite(16, HIGH);
+  CHECK_EQ(simChips[1].get(MCP23XXX_OLAT, 0), 0x01);
+  CHECK_EQ(simChips[1].get(MCP23XXX_OLAT, 1), 0x0F);
+}
+
+TEST(bank_pin_out_of_range) {
+  Adafruit_MCP23X17_Bank<1> bank;
+  simReset();
+  CHECK(bank.begin_I2C());
+  uint32_t before = simTransactions();
+
+  bank.pinMode(16, OUTPUT);
+  bank.setPin(16, HIGH);
+  bank.digitalWrite(300, HIGH);
+  bank.flush();
+  CHECK_EQ(bank.digitalRead(16), LOW);
+  CHECK_EQ(simTransactions(), before);
+  // chip 1 is outside the bank
+  CHECK_EQ(simChips[1].transactions, 0);
+}
@@ -0,0 +1,62 @@
+/*!
+ * @file test_batch.cpp
+ *
+ * Host tests of the mask and batched output calls.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(batch_single_transfer) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp, true));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+
+  uint32_t before = simTransactions();
+  mcp.beginBatch();
+  mcp.digitalWrite(0, HIGH);
+  mcp.digitalWrite(9, HIGH);
+  mcp.digitalWriteMask(0xF000, 0x5000);
+  CHECK(mcp.commit());
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(simChips[0].getOutputs(), 0x5201);
+}
+
+TEST(mask_calls) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+
+  mcp.pinModeMask(0x0F0F, OUTPUT);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 0), 0xF0);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 1), 0xF0);
+  mcp.digitalWriteMask(0x0F0F, 0x0A05);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0A05);
+}
+
+TEST(batch_failures) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  mcp.writeGPIOAB(0x0100);
+
+  // no batch to commit
+  CHECK(!mcp.commit());
+
+  // no batch is started without the output latches
+  simChips[0].failures = 1;
+  CHECK(!mcp.beginBatch());
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0101);
+
+  // a failed commit keeps the batch open for another try
+  CHECK(mcp.beginBatch());
+  mcp.digitalWrite(1, HIGH);
+  simChips[0].failures = 1;
+  CHECK(!mcp.commit());
+  CHECK_EQ(simChips[0].getOutputs(), 0x0101);
+  CHECK(mcp.commit());
+  CHECK_EQ(simChips[0].getOutputs(), 0x0103);
+  CHECK(!mcp.commit());
+}
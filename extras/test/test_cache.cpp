@@ -0,0 +1,34 @@
+/*!
+ * @file test_cache.cpp
+ *
+ * Host tests of the register cache.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(cache_skips_reads) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp, true));
+
+  uint32_t before = simTransactions();
+  mcp.pinMode(3, OUTPUT); // IODIR only, GPPU is unchanged
+  mcp.digitalWrite(3, HIGH);
+  mcp.digitalWrite(3, HIGH); // already set
+  CHECK_EQ(simTransactions() - before, 2);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0008);
+}
+
+TEST(cache_refresh) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp, true));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+
+  // changed behind the library's back
+  simChips[0].set(MCP23XXX_OLAT, 0x80, 1);
+  CHECK(mcp.refreshCache());
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[0].getOutputs(), 0x8001);
+}
@@ -0,0 +1,65 @@
+/*!
+ * @file test_clock.cpp
+ *
+ * Host tests of the bus clock setting and auto-tuning.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(set_bus_clock) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+
+  CHECK(mcp.setBusClock(400000));
+  CHECK_EQ(mcp.getBusClock(), 400000);
+  CHECK_EQ(Wire.getClock(), 400000);
+  uint32_t start = simTime();
+  mcp.readGPIOAB();
+  CHECK(simTime() - start < 200);
+}
+
+TEST(auto_tune_restores) {
+  Adafruit_MCP23X17 mcp;
+  const uint32_t freqs[] = {100000, 400000, 1000000};
+  CHECK(simStart(&mcp, true));
+  mcp.setupInterruptPin(0, CHANGE);
+  mcp.setupInterruptPin(8, CHANGE);
+  mcp.pinMode(3, OUTPUT);
+  mcp.digitalWrite(3, HIGH);
+  CHECK(mcp.setBusClock(100000));
+
+  CHECK_EQ(mcp.autoTuneClock(freqs, 3, 1), 400000);
+  CHECK_EQ(mcp.getBusClock(), 400000);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IPOL, 0), 0x00);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0008);
+  CHECK_EQ(mcp.getInterruptEnabled(), 0x0101);
+  CHECK(!simChips[0].intActive());
+}
+
+TEST(auto_tune_unknown_clock) {
+  Adafruit_MCP23X17 mcp;
+  const uint32_t freqs[] = {400000, 1000000};
+  CHECK(simStart(&mcp));
+  Wire.setClock(50000);
+
+  // the clock Wire runs at cannot be restored, nothing is tuned
+  uint32_t before = simTransactions();
+  CHECK_EQ(mcp.autoTuneClock(freqs, 2), 0);
+  CHECK_EQ(simTransactions(), before);
+  CHECK_EQ(Wire.getClock(), 50000);
+  CHECK_EQ(mcp.getBusClock(), 0);
+}
+
+TEST(begin_resets_spi_bus) {
+  Adafruit_MCP23X17 mcp;
+  simReset();
+  CHECK(mcp.begin_SPI(10, &SPI));
+  CHECK(mcp.begin_SPI(10, 11, 12, 13));
+
+  // software SPI has no clock to set, the earlier hardware bus is not used
+  CHECK(!mcp.setBusClock(400000));
+  CHECK_EQ(mcp.getBusClock(), 0);
+}
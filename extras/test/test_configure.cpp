@@ -0,0 +1,41 @@
+/*!
+ * @file test_configure.cpp
+ *
+ * Host tests of the one call port configuration.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(configure_and_verify) {
+  Adafruit_MCP23X17 mcp;
+  MCP23XXX_PortConfig config = {0xFF0F, 0x0100, 0x0300, 0x0000,
+                                0x0000, 0xF000, 0x00A0};
+  CHECK(simStart(&mcp, true));
+
+  uint32_t before = simTransactions();
+  CHECK(mcp.configure(config, true));
+  // OLAT, IODIR..GPPU, GPINTEN, then two reads to verify
+  CHECK_EQ(simTransactions() - before, 5);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 0), 0x0F);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IPOL, 1), 0x01);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPINTEN, 1), 0x03);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPPU, 1), 0xF0);
+  CHECK_EQ(simChips[0].getOutputs(), 0x00A0);
+}
+
+TEST(configure_iocon_read_fails) {
+  Adafruit_MCP23X17 mcp;
+  MCP23XXX_PortConfig config = {0x0000, 0, 0, 0, 0, 0, 0xFFFF};
+  CHECK(simStart(&mcp));
+
+  // nothing is written when IOCON cannot be read
+  simChips[0].failures = 1;
+  uint32_t before = simTransactions();
+  CHECK(!mcp.configure(config));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 0), 0xFF);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0000);
+}
@@ -0,0 +1,36 @@
+/*!
+ * @file test_debouncer.cpp
+ *
+ * Host tests of the bit-parallel debouncer.
+ */
+
+#include "test.h"
+
+#include <Adafruit_MCP23XXX_Debouncer.h>
+
+TEST(debouncer) {
+  Adafruit_MCP23XXX_Debouncer debouncer(3);
+
+  debouncer.update(0x0001);
+  debouncer.update(0x0001);
+  CHECK_EQ(debouncer.read(), 0);
+  debouncer.update(0x0001);
+  CHECK_EQ(debouncer.read(), 0x0001);
+  CHECK_EQ(debouncer.rose(), 0x0001);
+  debouncer.update(0x0000);
+  CHECK_EQ(debouncer.read(), 0x0001);
+  CHECK_EQ(debouncer.changed(), 0);
+}
+
+TEST(debouncer_bounce) {
+  Adafruit_MCP23XXX_Debouncer debouncer(2, 0x8000);
+
+  // a pin that keeps bouncing never changes
+  for (uint8_t i = 0; i < 10; i++)
+    debouncer.update((i & 1) ? 0x8000 : 0x0000);
+  CHECK_EQ(debouncer.read(), 0x8000);
+  debouncer.update(0x0000);
+  debouncer.update(0x0000);
+  CHECK_EQ(debouncer.read(), 0x0000);
+  CHECK_EQ(debouncer.fell(), 0x8000);
+}
@@ -0,0 +1,105 @@
+/*!
+ * @file test_dispatcher.cpp
+ *
+ * Host tests of the wired-OR interrupt dispatcher.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23XXX_Dispatcher.h>
+
+static uint8_t dispatched[8];
+static uint8_t dispatchCount;
+static bool fireAgain;
+
+static void onDispatch(uint8_t chip, uint16_t flags, uint16_t captured) {
+  (void)flags;
+  (void)captured;
+  if (dispatchCount < 8)
+    dispatched[dispatchCount++] = chip;
+  // chip 0 fires again while chip 1 is serviced
+  if (fireAgain && chip == 1 && dispatchCount == 2)
+    simChips[0].setInputs(0x0000);
+}
+
+/*!
+    @brief  Start two chips sharing the INT line, with pin 0 enabled.
+    @param mcp the two chips
+*/
+static void startChips(Adafruit_MCP23X17 *mcp) {
+  simReset();
+  for (uint8_t i = 0; i < 2; i++) {
+    CHECK(mcp[i].begin_I2C(MCP23XXX_ADDR + i));
+    mcp[i].setupInterrupts(true, true, LOW);
+    mcp[i].setupInterruptPin(0, CHANGE);
+  }
+  dispatchCount = 0;
+}
+
+TEST(dispatcher_services_all) {
+  Adafruit_MCP23X17 mcp[3];
+  Adafruit_MCP23XXX *chips[3] = {&mcp[0], &mcp[1], &mcp[2]};
+  startChips(mcp);
+  CHECK(mcp[2].begin_I2C(MCP23XXX_ADDR + 2));
+  Adafruit_MCP23XXX_Dispatcher dispatcher(chips, 3, SIM_INT_PIN);
+  dispatcher.refresh();
+  fireAgain = false;
+
+  simChips[0].setInputs(0x0001);
+  simChips[1].setInputs(0x0001);
+  uint32_t before = simChips[2].transactions;
+  CHECK_EQ(dispatcher.dispatch(onDispatch), 2);
+  CHECK_EQ(dispatched[0], 0);
+  CHECK_EQ(dispatched[1], 1);
+  CHECK_EQ(digitalRead(SIM_INT_PIN), HIGH);
+  // no interrupts enabled, never read
+  CHECK_EQ(simChips[2].transactions, before);
+}
+
+TEST(dispatcher_repeats_passes) {
+  Adafruit_MCP23X17 mcp[2];
+  Adafruit_MCP23XXX *chips[2] = {&mcp[0], &mcp[1]};
+  startChips(mcp);
+  Adafruit_MCP23XXX_Dispatcher dispatcher(chips, 2, SIM_INT_PIN);
+  dispatcher.refresh();
+  fireAgain = true;
+
+  simChips[0].setInputs(0x0001);
+  simChips[1].setInputs(0x0001);
+  CHECK_EQ(dispatcher.dispatch(onDispatch), 3);
+  CHECK_EQ(dispatched[0], 0);
+  CHECK_EQ(dispatched[1], 1);
+  CHECK_EQ(dispatched[2], 0);
+  CHECK_EQ(digitalRead(SIM_INT_PIN), HIGH);
+}
+
+TEST(dispatcher_refreshes_lazily) {
+  Adafruit_MCP23X17 mcp[2];
+  Adafruit_MCP23XXX *chips[2] = {&mcp[0], &mcp[1]};
+  // constructed before the chips are started, as a global would be
+  Adafruit_MCP23XXX_Dispatcher dispatcher(chips, 2, SIM_INT_PIN);
+  startChips(mcp);
+  fireAgain = false;
+
+  simChips[1].setInputs(0x0001);
+  CHECK_EQ(dispatcher.dispatch(onDispatch), 1);
+  CHECK_EQ(dispatched[0], 1);
+}
+
+TEST(dispatcher_refresh_read_fails) {
+  Adafruit_MCP23X17 mcp[2];
+  Adafruit_MCP23XXX *chips[2] = {&mcp[0], &mcp[1]};
+  startChips(mcp);
+  Adafruit_MCP23XXX_Dispatcher dispatcher(chips, 2, SIM_INT_PIN);
+  CHECK(dispatcher.refresh());
+  fireAgain = false;
+
+  // chip 0 keeps its interrupt enabled state, also when dispatch() retries
+  simChips[0].failures = 2;
+  CHECK(!dispatcher.refresh());
+  simChips[0].setInputs(0x0001);
+  CHECK_EQ(dispatcher.dispatch(onDispatch), 1);
+  CHECK_EQ(dispatched[0], 0);
+}
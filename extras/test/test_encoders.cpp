@@ -0,0 +1,60 @@
+/*!
+ * @file test_encoders.cpp
+ *
+ * Host tests of the quadrature encoder decoder.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23XXX_Encoders.h>
+
+TEST(encoders_count) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Encoders encoders(&mcp);
+  const uint16_t cycle[4] = {0x0001, 0x0000, 0x0002, 0x0003};
+  CHECK(simStart(&mcp));
+  simChips[0].setInputs(0x0003);
+  CHECK_EQ(encoders.add(0, 1), 0);
+  mcp.clearInterrupts();
+
+  for (uint8_t i = 0; i < 4; i++) {
+    simChips[0].setInputs(cycle[i]);
+    CHECK(encoders.update());
+  }
+  int32_t turn = encoders.getPosition(0);
+  CHECK(turn == 4 || turn == -4);
+  for (int8_t i = 2; i >= 0; i--) {
+    simChips[0].setInputs(cycle[i]);
+    CHECK(encoders.update());
+  }
+  CHECK_EQ(encoders.getPosition(0), turn / 4);
+  CHECK_EQ(encoders.getLostSteps(0), 0);
+  encoders.setPosition(0, 100);
+  CHECK_EQ(encoders.getPosition(0), 100);
+  CHECK(!encoders.update());
+}
+
+TEST(encoders_idle_port) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Encoders encoders(&mcp);
+  CHECK(simStart(&mcp));
+  simChips[0].setInputs(0x0303);
+  CHECK_EQ(encoders.add(0, 1), 0);
+  CHECK_EQ(encoders.add(8, 9), 1);
+  mcp.clearInterrupts();
+
+  // only Port A interrupts, INTCAPB still holds its reset value
+  simChips[0].setInputs(0x0302);
+  CHECK(encoders.update());
+  CHECK_EQ(encoders.getPosition(0) != 0, 1);
+  CHECK_EQ(encoders.getPosition(1), 0);
+  CHECK_EQ(encoders.getLostSteps(1), 0);
+
+  simChips[0].setInputs(0x0102);
+  CHECK(encoders.update());
+  CHECK_EQ(encoders.getPosition(1) != 0, 1);
+  CHECK_EQ(encoders.getLostSteps(0), 0);
+  CHECK_EQ(encoders.getLostSteps(1), 0);
+}
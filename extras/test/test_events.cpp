@@ -0,0 +1,69 @@
+/*!
+ * @file test_events.cpp
+ *
+ * Host tests of the timestamped pin change event queue.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23XXX_Events.h>
+
+static uint8_t eventPin;
+static uint8_t eventLevel;
+
+static void onEvent(uint8_t pin, uint8_t level, uint32_t timestamp) {
+  (void)timestamp;
+  eventPin = pin;
+  eventLevel = level;
+}
+
+TEST(events_queue) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Events events(&mcp);
+  MCP23XXX_Event event;
+  CHECK(simStart(&mcp));
+  mcp.setupInterruptPin(4, CHANGE);
+  events.onPin(4, onEvent);
+  eventPin = 0;
+
+  CHECK(!events.capture());
+  uint32_t fired = micros();
+  simChips[0].setInputs(0x0010);
+  events.handleInterrupt();
+  CHECK(events.capture());
+  CHECK(!simChips[0].intActive());
+  CHECK_EQ(events.available(), 1);
+  CHECK(events.pop(&event));
+  CHECK_EQ(event.flags, 0x0010);
+  CHECK_EQ(event.captured, 0x0010);
+  CHECK(event.timestamp > fired);
+
+  simChips[0].setInputs(0x0000);
+  events.handleInterrupt();
+  CHECK(events.capture());
+  CHECK_EQ(events.drain(), 1);
+  CHECK_EQ(eventPin, 4);
+  CHECK_EQ(eventLevel, LOW);
+}
+
+TEST(events_retry_failed_read) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Events events(&mcp);
+  MCP23XXX_Event event;
+  CHECK(simStart(&mcp));
+  mcp.setupInterruptPin(4, CHANGE);
+
+  simChips[0].setInputs(0x0010);
+  events.handleInterrupt();
+  simChips[0].failures = 1;
+  CHECK(!events.capture());
+  CHECK_EQ(events.available(), 0);
+  CHECK(events.capture());
+  CHECK_EQ(events.available(), 1);
+  CHECK(events.pop(&event));
+  CHECK_EQ(event.flags, 0x0010);
+  CHECK_EQ(event.captured, 0x0010);
+  CHECK(!simChips[0].intActive());
+}
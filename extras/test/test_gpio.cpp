@@ -0,0 +1,101 @@
+/*!
+ * @file test_gpio.cpp
+ *
+ * Host tests of the basic pin API on MCP23017 and MCP23008, over I2C and
+ * SPI.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X08.h>
+#include <Adafruit_MCP23X17.h>
+#include <type_traits>
+
+// the bus device lives inside the object, a copy would share it
+static_assert(!std::is_copy_constructible<Adafruit_MCP23X17>::value,
+              "MCP23X17 must not be copyable");
+static_assert(!std::is_copy_assignable<Adafruit_MCP23X17>::value,
+              "MCP23X17 must not be assignable");
+
+TEST(pin_write_read) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+
+  mcp.pinMode(3, OUTPUT);
+  mcp.digitalWrite(3, HIGH);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0008);
+  mcp.pinMode(9, INPUT_PULLUP);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPPU, 1), 0x02);
+  simChips[0].setInputs(0x0200);
+  CHECK_EQ(mcp.digitalRead(9), HIGH);
+  CHECK_EQ(mcp.readGPIOAB(), 0x0208);
+}
+
+TEST(mcp23008) {
+  Adafruit_MCP23X08 mcp;
+  MCP23XXX_Registers regs;
+  simReset(false);
+  CHECK(mcp.begin_I2C());
+
+  mcp.pinModeMask(0x000F, OUTPUT);
+  mcp.digitalWriteMask(0x000F, 0x0005);
+  CHECK_EQ(simChips[0].getOutputs(), 0x0005);
+  simChips[0].setInputs(0x0080);
+  CHECK_EQ(mcp.readGPIO(), 0x85);
+  CHECK(mcp.readAllRegisters(&regs));
+  CHECK_EQ(regs.iodir[0], 0xF0);
+  CHECK_EQ(regs.olat[0], 0x05);
+}
+
+TEST(spi_hardware_address) {
+  Adafruit_MCP23X17 mcp;
+  simReset();
+  CHECK(mcp.begin_SPI(10, &SPI, 3));
+  mcp.enableAddrPins();
+
+  mcp.pinMode(0, OUTPUT);
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[3].getOutputs(), 0x0001);
+  CHECK_EQ(simChips[0].getOutputs(), 0);
+  CHECK_EQ(simChips[2].getOutputs(), 0);
+}
+
+TEST(spi_haen_quirk) {
+  Adafruit_MCP23X17 mcp;
+  simReset();
+  CHECK(mcp.begin_SPI(10, &SPI, 5));
+
+  // without HAEN every chip with A2 = 1 answers address 5
+  mcp.pinMode(0, OUTPUT);
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[4].getOutputs(), 0x0001);
+  CHECK_EQ(simChips[7].getOutputs(), 0x0001);
+  CHECK_EQ(simChips[0].getOutputs(), 0);
+
+  // the write to address 0 misses chips with A2 = 1, the second reaches them
+  simReset();
+  mcp.enableAddrPins();
+  for (uint8_t i = 0; i < SIM_CHIPS; i++)
+    CHECK(simChips[i].get(MCP23XXX_IOCON) & (1 << 3));
+  CHECK_EQ(simChips[0].transactions, 1);
+  CHECK_EQ(simChips[4].transactions, 1);
+
+  mcp.pinMode(0, OUTPUT);
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[5].getOutputs(), 0x0001);
+  CHECK_EQ(simChips[4].getOutputs(), 0);
+}
+
+TEST(begin_again_on_other_bus) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+  CHECK(mcp.begin_SPI(10, &SPI, 2));
+  CHECK(mcp.begin_I2C(MCP23XXX_ADDR + 1));
+  uint32_t spiTransactions = simChips[2].transactions;
+
+  mcp.pinMode(0, OUTPUT);
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[1].getOutputs(), 0x0001);
+  CHECK_EQ(simChips[2].transactions, spiTransactions);
+}
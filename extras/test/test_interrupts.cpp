@@ -0,0 +1,53 @@
+/*!
+ * @file test_interrupts.cpp
+ *
+ * Host tests of interrupt setup and the single transfer service call.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(service_interrupt) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp, true));
+  mcp.setupInterrupts(true, true, LOW);
+  mcp.setupInterruptPin(2, CHANGE);
+  mcp.setupInterruptPin(10, CHANGE);
+
+  simChips[0].setInputs(0x0404);
+  CHECK(simChips[0].intActive());
+  CHECK_EQ(digitalRead(SIM_INT_PIN), LOW);
+
+  uint32_t before = simTransactions();
+  MCP23XXX_Interrupt irq = mcp.serviceInterrupt(true);
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(irq.flags, 0x0404);
+  CHECK_EQ(irq.captured, 0x0404);
+  CHECK_EQ(irq.current, 0x0404);
+  CHECK_EQ(digitalRead(SIM_INT_PIN), HIGH);
+}
+
+TEST(last_interrupt_pin) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+  simChips[0].setInputs(0x1000);
+  mcp.setupInterruptPin(12, LOW);
+  CHECK_EQ(mcp.getInterruptEnabled(), 0x1000);
+  CHECK(!simChips[0].intActive());
+
+  simChips[0].setInputs(0x0000);
+  CHECK(simChips[0].intActive());
+  CHECK_EQ(mcp.getLastInterruptPin(), 12);
+  CHECK_EQ(mcp.getCapturedInterrupt(), 0x0000);
+  // compared against DEFVAL, INT stays active while the pin is LOW
+  CHECK(simChips[0].intActive());
+  simChips[0].setInputs(0x1000);
+  mcp.clearInterrupts();
+  CHECK(!simChips[0].intActive());
+
+  mcp.disableInterruptPin(12);
+  simChips[0].setInputs(0x0000);
+  CHECK(!simChips[0].intActive());
+}
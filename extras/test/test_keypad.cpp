@@ -0,0 +1,118 @@
+/*!
+ * @file test_keypad.cpp
+ *
+ * Host tests of the key matrix scanner, with the matrix modelled by the
+ * simulator wiring hook.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23X17_Keypad.h>
+
+static uint8_t keyRow;
+static uint8_t keyCol;
+static bool keyDown;
+
+/*!
+    @brief  Key matrix between Port A rows and Port B columns. A held key
+    pulls its column LOW while its row is driven LOW.
+    @param chip simulated chip
+*/
+static void keyMatrix(SimChip *chip) {
+  uint8_t low = ~chip->get(MCP23XXX_IODIR, 0) & ~chip->get(MCP23XXX_OLAT, 0);
+  uint16_t levels = 0xFFFF;
+
+  if (keyDown && (low & (1 << keyRow)))
+    levels &= ~(1 << (8 + keyCol));
+  chip->setInputs(levels);
+}
+
+/*!
+    @brief  Fail the transfer after the first row is driven, which reads
+    the columns.
+    @param chip simulated chip
+*/
+static void failColumnRead(SimChip *chip) {
+  chip->failures = 1;
+  chip->wiring = keyMatrix;
+  keyMatrix(chip);
+}
+
+TEST(keypad_scan) {
+  for (uint8_t drive = 0; drive < 2; drive++) {
+    Adafruit_MCP23X17 mcp;
+    Adafruit_MCP23X17_Keypad keypad(&mcp, 4, 4);
+    simReset();
+    simChips[0].wiring = keyMatrix;
+    keyDown = false;
+    CHECK(mcp.begin_I2C());
+    CHECK(keypad.begin(drive));
+    CHECK(!keypad.update());
+
+    keyRow = 1;
+    keyCol = 2;
+    keyDown = true;
+    CHECK(keypad.update());
+    CHECK(keypad.isPressed(1, 2));
+    CHECK_EQ(keypad.getKeys(), 1UL << (1 * 8 + 2));
+    CHECK(!keypad.ghosting());
+
+    keyDown = false;
+    CHECK(keypad.update());
+    CHECK_EQ(keypad.getKeys(), 0);
+  }
+}
+
+TEST(keypad_keeps_other_pins) {
+  for (uint8_t drive = 0; drive < 2; drive++) {
+    Adafruit_MCP23X17 mcp;
+    Adafruit_MCP23X17_Keypad keypad(&mcp, 4, 4);
+    simReset();
+    simChips[0].wiring = keyMatrix;
+    keyDown = false;
+    CHECK(mcp.begin_I2C());
+    mcp.enableCache();
+    // pin 7 a HIGH output, pin 14 inverted, pin 15 with a LOW interrupt
+    mcp.pinMode(7, OUTPUT);
+    mcp.digitalWrite(7, HIGH);
+    mcp.pinMode(15, INPUT);
+    mcp.setupInterruptPin(15, LOW);
+    simChips[0].set(MCP23XXX_IPOL, 0x40, 1);
+    CHECK(mcp.refreshCache());
+    CHECK(keypad.begin(drive));
+
+    keyRow = 3;
+    keyCol = 0;
+    keyDown = true;
+    CHECK(keypad.update());
+    CHECK(keypad.isPressed(3, 0));
+    CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 0), 0x70);
+    CHECK_EQ(simChips[0].getOutputs() & 0x80, 0x80);
+    CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 1), 0xFF);
+    CHECK_EQ(simChips[0].get(MCP23XXX_IPOL, 1), 0x40);
+    CHECK_EQ(simChips[0].get(MCP23XXX_INTCON, 1), 0x80);
+    CHECK_EQ(simChips[0].get(MCP23XXX_DEFVAL, 1), 0x80);
+    CHECK_EQ(simChips[0].get(MCP23XXX_GPINTEN, 1), 0x8F);
+  }
+}
+
+TEST(keypad_scan_fails) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23X17_Keypad keypad(&mcp, 4, 4);
+  simReset();
+  simChips[0].wiring = keyMatrix;
+  keyRow = 0;
+  keyCol = 1;
+  keyDown = true;
+  CHECK(mcp.begin_I2C());
+  mcp.enableCache();
+  CHECK(keypad.begin());
+  CHECK(keypad.scan());
+
+  // a failed column read is not every key pressed
+  simChips[0].wiring = failColumnRead;
+  CHECK(!keypad.scan());
+  CHECK_EQ(keypad.getKeys(), 1UL << 1);
+}
@@ -0,0 +1,38 @@
+/*!
+ * @file test_main.cpp
+ *
+ * Runs all registered host tests.
+ */
+
+#include "test.h"
+
+int testFailures = 0;
+
+static TestCase *tests = nullptr;
+static TestCase *last = nullptr;
+
+TestCase::TestCase(const char *name, void (*run)()) {
+  this->name = name;
+  this->run = run;
+  next = nullptr;
+  // keep the order of definition
+  if (last)
+    last->next = this;
+  else
+    tests = this;
+  last = this;
+}
+
+int main() {
+  int count = 0;
+
+  for (TestCase *test = tests; test; test = test->next) {
+    int before = testFailures;
+    test->run();
+    printf("%s %s\n", (testFailures == before) ? "ok  " : "FAIL", test->name);
+    count++;
+  }
+  printf("%d tests, %d failed checks\n", count, testFailures);
+
+  return testFailures ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+/*!
+ * @file test_poller.cpp
+ *
+ * Host tests of the adaptive change poller.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23XXX_Poller.h>
+
+static uint16_t pollChanged;
+static uint16_t pollValues;
+
+static void onChange(uint16_t changed, uint16_t values) {
+  pollChanged = changed;
+  pollValues = values;
+}
+
+TEST(poller_reports_changes) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Poller poller(&mcp);
+  CHECK(simStart(&mcp));
+  CHECK(poller.subscribe(0x0100, onChange));
+  pollChanged = 0;
+
+  for (uint16_t i = 0; i < 10000 && poller.getReads() < 2; i++)
+    poller.poll();
+  CHECK_EQ(pollChanged, 0);
+
+  simChips[0].setInputs(0x0101);
+  for (uint32_t i = 0; i < 100000 && !pollChanged; i++)
+    poller.poll();
+  CHECK_EQ(pollChanged, 0x0100);
+  CHECK_EQ(pollValues & 0x0100, 0x0100);
+}
+
+TEST(poller_backs_off) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Poller poller(&mcp, 1000, 8000);
+  CHECK(simStart(&mcp));
+  CHECK(poller.subscribe(0x0001, onChange));
+
+  // idle pins are polled less often, Port B is never read
+  for (uint32_t i = 0; i < 100000 && poller.getInterval() < 8000; i++)
+    poller.poll();
+  CHECK_EQ(poller.getInterval(), 8000);
+  CHECK(simChips[0].bytes <= 2 * poller.getReads() + 10);
+}
+
+TEST(poller_read_fails) {
+  Adafruit_MCP23X17 mcp;
+  Adafruit_MCP23XXX_Poller poller(&mcp, 1000, 1000);
+  CHECK(simStart(&mcp));
+  simChips[0].setInputs(0x0101);
+  CHECK(poller.subscribe(0x0101, onChange));
+  CHECK(poller.poll());
+  pollChanged = 0;
+
+  // a failed read is not a change to all zeros
+  simChips[0].failures = 1;
+  uint32_t reads = poller.getReads();
+  uint32_t before = simChips[0].transactions;
+  for (uint32_t i = 0; i < 100000 && simChips[0].transactions == before; i++)
+    poller.poll();
+  CHECK_EQ(poller.getReads(), reads);
+  CHECK_EQ(pollChanged, 0);
+
+  // the next read compares against the last good one
+  for (uint32_t i = 0; i < 100000 && poller.getReads() == reads; i++)
+    poller.poll();
+  CHECK_EQ(poller.getReads(), reads + 1);
+  CHECK_EQ(pollChanged, 0);
+}
@@ -0,0 +1,116 @@
+/*!
+ * @file test_regbank.cpp
+ *
+ * Host tests of the IOCON.BANK=1 register layout.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(bank1_layout) {
+  Adafruit_MCP23X17 mcp;
+  uint8_t regs[MCP23XXX_OLAT + 1];
+  CHECK(simStart(&mcp, true));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  mcp.writeGPIOAB(0x1234);
+
+  CHECK(mcp.setRegisterBank(1));
+  CHECK_EQ(mcp.getRegisterBank(), 1);
+  CHECK(simChips[0].get(MCP23XXX_IOCON) & (1 << 7));
+  CHECK_EQ(mcp.readGPIOAB(), 0x1234);
+
+  // a port is one contiguous block
+  uint32_t before = simTransactions();
+  CHECK(mcp.readPortRegisters(regs, 1));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(regs[MCP23XXX_OLAT], 0x12);
+  regs[MCP23XXX_OLAT] = 0x56;
+  regs[MCP23XXX_GPPU] = 0x0F;
+  before = simTransactions();
+  CHECK(mcp.writePortRegisters(regs, 1));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(simChips[0].getOutputs(), 0x5634);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPPU, 1), 0x0F);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPPU, 0), 0x00);
+
+  // both ports take one transfer each
+  before = simTransactions();
+  mcp.digitalWriteMask(0xFFFF, 0xABCD);
+  CHECK_EQ(simTransactions() - before, 2);
+  CHECK_EQ(simChips[0].getOutputs(), 0xABCD);
+
+  CHECK(mcp.setRegisterBank(0));
+  CHECK_EQ(simChips[0].get(MCP23XXX_IOCON) & (1 << 7), 0);
+  mcp.digitalWrite(0, LOW);
+  CHECK_EQ(simChips[0].getOutputs(), 0xABCC);
+}
+
+TEST(bank1_interrupts) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+  CHECK(mcp.setRegisterBank(1));
+  mcp.setupInterruptPin(9, CHANGE);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPINTEN, 1), 0x02);
+
+  simChips[0].setInputs(0x0200);
+  MCP23XXX_Interrupt irq = mcp.serviceInterrupt(true);
+  CHECK_EQ(irq.flags, 0x0200);
+  CHECK_EQ(irq.captured, 0x0200);
+  CHECK(!simChips[0].intActive());
+}
+
+TEST(bank_iocon_read_fails) {
+  Adafruit_MCP23X17 mcp;
+  uint8_t regs[MCP23XXX_OLAT + 1] = {};
+  CHECK(simStart(&mcp));
+
+  // nothing is written when IOCON cannot be read
+  simChips[0].failures = 1;
+  uint32_t before = simTransactions();
+  CHECK(!mcp.setRegisterBank(1));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(mcp.getRegisterBank(), 0);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IOCON) & (1 << 7), 0);
+
+  CHECK(mcp.setRegisterBank(1));
+  simChips[0].failures = 1;
+  before = simTransactions();
+  CHECK(!mcp.writePortRegisters(regs, 0));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IODIR, 0), 0xFF);
+}
+
+TEST(bank1_detected_by_begin) {
+  Adafruit_MCP23X17 mcp;
+  CHECK(simStart(&mcp));
+  CHECK(mcp.setRegisterBank(1));
+
+  // microcontroller reset, the chip stays in BANK=1
+  Adafruit_MCP23X17 again;
+  again.enableCache();
+  CHECK(again.begin_I2C());
+  CHECK_EQ(again.getRegisterBank(), 1);
+  again.pinModeMask(0xFFFF, OUTPUT);
+  again.writeGPIOAB(0x1234);
+  CHECK_EQ(simChips[0].getOutputs(), 0x1234);
+
+  // with BANK=0, a GPINTENB bit 7 does not look like BANK=1
+  CHECK(again.setRegisterBank(0));
+  again.setupInterruptPin(15, CHANGE);
+  uint32_t before = simTransactions();
+  CHECK(mcp.begin_I2C());
+  CHECK_EQ(mcp.getRegisterBank(), 0);
+  CHECK_EQ(simTransactions() - before, 2);
+  mcp.digitalWrite(0, LOW);
+  CHECK_EQ(simChips[0].getOutputs(), 0x1234 & ~1);
+}
+
+TEST(bank_detect_read_fails) {
+  Adafruit_MCP23X17 mcp;
+  simReset();
+  simChips[0].failures = 1;
+  CHECK(!mcp.begin_I2C());
+  CHECK_EQ(mcp.getRegisterBank(), 0);
+}
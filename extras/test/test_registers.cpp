@@ -0,0 +1,75 @@
+/*!
+ * @file test_registers.cpp
+ *
+ * Host tests of the register file snapshot and restore.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X08.h>
+#include <Adafruit_MCP23X17.h>
+
+TEST(register_file_round_trip) {
+  Adafruit_MCP23X17 mcp;
+  MCP23XXX_Registers regs;
+  CHECK(simStart(&mcp));
+
+  uint32_t before = simTransactions();
+  CHECK(mcp.readAllRegisters(&regs));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(regs.iodir[1], 0xFF);
+
+  regs.iodir[1] = 0x0F;
+  regs.olat[1] = 0x30;
+  regs.gppu[0] = 0x81;
+  CHECK(mcp.writeAllRegisters(&regs));
+  CHECK_EQ(simChips[0].getOutputs(), 0x3000);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPPU, 0), 0x81);
+}
+
+TEST(register_file_restore_no_glitch) {
+  Adafruit_MCP23X17 mcp;
+  MCP23XXX_Registers regs;
+
+  for (uint8_t bank = 0; bank < 2; bank++) {
+    CHECK(simStart(&mcp, true));
+    CHECK(mcp.setRegisterBank(bank));
+    CHECK(mcp.readAllRegisters(&regs));
+    // inputs with stale latches, restored as LOW outputs
+    simChips[0].set(MCP23XXX_OLAT, 0xFF, 0);
+    simChips[0].set(MCP23XXX_OLAT, 0xFF, 1);
+    regs.iodir[0] = regs.iodir[1] = 0x00;
+    regs.olat[0] = 0x00;
+    regs.olat[1] = 0x0F;
+
+    uint32_t before = simTransactions();
+    CHECK(mcp.writeAllRegisters(&regs));
+    CHECK_EQ(simTransactions() - before, bank ? 4 : 1);
+    CHECK_EQ(simChips[0].drivenHigh, 0x0F00);
+    CHECK_EQ(simChips[0].getOutputs(), 0x0F00);
+    CHECK_EQ(mcp.readGPIOAB(), 0x0F00);
+    // the cache follows the burst around the wrap
+    before = simTransactions();
+    mcp.pinMode(0, OUTPUT);
+    CHECK_EQ(simTransactions() - before, 0);
+  }
+}
+
+TEST(register_file_mcp23008) {
+  Adafruit_MCP23X08 mcp;
+  MCP23XXX_Registers regs;
+  simReset(false);
+  CHECK(mcp.begin_I2C());
+  CHECK(mcp.readAllRegisters(&regs));
+  simChips[0].set(MCP23XXX_OLAT, 0xFF);
+  regs.iodir[0] = 0x00;
+  regs.olat[0] = 0x0F;
+  regs.gppu[0] = 0x80;
+
+  uint32_t before = simTransactions();
+  CHECK(mcp.writeAllRegisters(&regs));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(simChips[0].drivenHigh, 0x000F);
+  CHECK_EQ(simChips[0].get(MCP23XXX_GPPU), 0x80);
+}
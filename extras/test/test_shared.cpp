@@ -0,0 +1,74 @@
+/*!
+ * @file test_shared.cpp
+ *
+ * Host tests of Adafruit_MCP23XXX_Shared with two std::thread writers.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+#include <Adafruit_MCP23XXX_Shared.h>
+#include <mutex>
+#include <thread>
+
+#define WRITES 2000 //!< Writes per thread
+
+/*! @brief Bus lock on a std::mutex. */
+class MutexLock : public MCP23XXX_BusLock {
+public:
+  void lock() { mutex.lock(); }
+  void unlock() { mutex.unlock(); }
+
+private:
+  std::mutex mutex;
+};
+
+/*!
+    @brief  Write a sequence of values to one port.
+    @param shared chip to write
+    @param mask pins of the port
+    @param last final value written
+*/
+static void writer(Adafruit_MCP23XXX_Shared *shared, uint16_t mask,
+                   uint16_t last) {
+  for (uint16_t i = 0; i < WRITES; i++)
+    shared->digitalWriteMask(mask, i | (i << 8));
+  shared->digitalWriteMask(mask, last);
+}
+
+TEST(shared_threads) {
+  Adafruit_MCP23X17 mcp;
+  MutexLock lock;
+  Adafruit_MCP23XXX_Shared shared(&mcp, &lock);
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  CHECK(shared.begin());
+
+  uint32_t before = simTransactions();
+  std::thread a(writer, &shared, 0x00FF, 0x00A5);
+  std::thread b(writer, &shared, 0xFF00, 0x5A00);
+  a.join();
+  b.join();
+
+  // changes of both threads survive, and writes never exceed the requests
+  CHECK_EQ(simChips[0].getOutputs(), 0x5AA5);
+  CHECK(simTransactions() - before <= 2 * (WRITES + 1));
+}
+
+TEST(shared_begin_loads_outputs) {
+  Adafruit_MCP23X17 mcp;
+  MutexLock lock;
+  Adafruit_MCP23XXX_Shared shared(&mcp, &lock);
+  CHECK(simStart(&mcp));
+  simChips[0].set(MCP23XXX_OLAT, 0x81, 1);
+
+  simChips[0].failures = 1;
+  CHECK(!shared.begin());
+  CHECK(shared.begin());
+  shared.pinMode(0, OUTPUT);
+  shared.pinMode(15, OUTPUT);
+  CHECK(shared.digitalWrite(0, HIGH));
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 0), 0x01);
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 1), 0x81);
+}
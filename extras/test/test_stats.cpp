@@ -0,0 +1,77 @@
+/*!
+ * @file test_stats.cpp
+ *
+ * Host tests of the bus statistics, built by "make stats".
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X08.h>
+#include <Adafruit_MCP23X17.h>
+
+#ifdef MCP23XXX_STATS
+
+static uint32_t transactions(Adafruit_MCP23XXX *mcp, uint8_t regClass) {
+  return mcp->getBusStats(regClass)->transactions;
+}
+
+TEST(stats_single_class) {
+  Adafruit_MCP23X17 mcp;
+
+  for (uint8_t bank = 0; bank < 2; bank++) {
+    CHECK(simStart(&mcp));
+    CHECK(mcp.setRegisterBank(bank));
+    mcp.resetBusStats();
+
+    mcp.readGPIOAB();
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_GPIO), bank ? 2 : 1);
+    MCP23XXX_Interrupt irq;
+    CHECK(mcp.serviceInterrupt(&irq));
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_INTERRUPT), bank ? 2 : 1);
+    CHECK_EQ(mcp.getBusStats(MCP23XXX_STATS_INTERRUPT)->bytesRead, 4);
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_CONFIG), 0);
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_BURST), 0);
+  }
+}
+
+TEST(stats_burst_across_classes) {
+  Adafruit_MCP23X17 mcp;
+  MCP23XXX_Registers regs;
+
+  for (uint8_t bank = 0; bank < 2; bank++) {
+    CHECK(simStart(&mcp));
+    CHECK(mcp.setRegisterBank(bank));
+    mcp.resetBusStats();
+
+    // INTF, INTCAP and GPIO in one read is neither class on its own
+    MCP23XXX_Interrupt irq;
+    CHECK(mcp.serviceInterrupt(&irq, true));
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_BURST), bank ? 2 : 1);
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_INTERRUPT), 0);
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_GPIO), 0);
+
+    mcp.resetBusStats();
+    CHECK(mcp.readAllRegisters(&regs));
+    CHECK(mcp.writeAllRegisters(&regs));
+    const MCP23XXX_BusStats *burst = mcp.getBusStats(MCP23XXX_STATS_BURST);
+    CHECK_EQ(burst->bytesRead, 22);
+    CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_CONFIG), 0);
+  }
+}
+
+TEST(stats_burst_wraps) {
+  Adafruit_MCP23X08 mcp;
+  MCP23XXX_Registers regs;
+  simReset(false);
+  CHECK(mcp.begin_I2C());
+  CHECK(mcp.readAllRegisters(&regs));
+  mcp.resetBusStats();
+
+  // OLAT wrapping around to IODIR
+  CHECK(mcp.writeAllRegisters(&regs));
+  CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_BURST), 1);
+  CHECK_EQ(transactions(&mcp, MCP23XXX_STATS_GPIO), 0);
+}
+
+#endif
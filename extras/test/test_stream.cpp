@@ -0,0 +1,138 @@
+/*!
+ * @file test_stream.cpp
+ *
+ * Host tests of streaming GPIO output and input.
+ */
+
+#include "sim.h"
+#include "test.h"
+
+#include <Adafruit_MCP23X17.h>
+
+TEST(stream_write_bursts) {
+  Adafruit_MCP23X17 mcp;
+  uint8_t values[40];
+  uint16_t pairs[3] = {0x0102, 0x0304, 0x0506};
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  mcp.writeGPIOAB(0x8000);
+  for (uint8_t i = 0; i < sizeof(values); i++)
+    values[i] = i;
+
+  // Port B is rewritten with its latch between the Port A values
+  uint32_t before = simTransactions();
+  CHECK(mcp.writeGPIOStream(values, sizeof(values)));
+  CHECK(simTransactions() - before < sizeof(values) / 4);
+  CHECK_EQ(simChips[0].getOutputs(), 0x8027);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IOCON) & (1 << 5), 0);
+
+  CHECK(mcp.writeGPIOABStream(pairs, 3));
+  CHECK_EQ(simChips[0].getOutputs(), 0x0506);
+}
+
+TEST(stream_read) {
+  Adafruit_MCP23X17 mcp;
+  uint8_t samples[40];
+  uint16_t pairs[5];
+  MCP23XXX_Run runs[4];
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0x00FF, OUTPUT);
+  mcp.writeGPIO(0x3C, 0);
+
+  simChips[0].setInputs(0xA500);
+  uint32_t before = simTransactions();
+  CHECK(mcp.readGPIOStream(samples, sizeof(samples), 1));
+  CHECK(simTransactions() - before < sizeof(samples) / 4);
+  CHECK_EQ(samples[0], 0xA5);
+  CHECK_EQ(samples[39], 0xA5);
+  CHECK(mcp.readGPIOABStream(pairs, 5));
+  CHECK_EQ(pairs[4], 0xA53C);
+  CHECK_EQ(mcp.readGPIOChanges(runs, 4, 9), 1);
+  CHECK_EQ(runs[0].value, 0xA53C);
+  CHECK_EQ(runs[0].length, 9);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IOCON) & (1 << 5), 0);
+}
+
+TEST(stream_read_keeps_cache) {
+  Adafruit_MCP23X17 mcp;
+  uint8_t samples[8];
+  uint16_t pairs[5];
+  MCP23XXX_Run runs[4];
+  CHECK(simStart(&mcp, true));
+  mcp.pinModeMask(0x00FF, OUTPUT);
+  mcp.pinModeMask(0xFF00, INPUT);
+
+  simChips[0].setInputs(0xA500);
+  CHECK(mcp.readGPIOStream(samples, 8, 1));
+  CHECK_EQ(samples[7], 0xA5);
+  // stream samples must not end up in the cached OLAT
+  mcp.digitalWrite(0, HIGH);
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 0), 0x01);
+
+  CHECK(mcp.readGPIOABStream(pairs, 5));
+  CHECK_EQ(pairs[4], 0xA501);
+  CHECK_EQ(mcp.readGPIOChanges(runs, 4, 9), 1);
+  CHECK_EQ(runs[0].length, 9);
+  mcp.pinMode(15, OUTPUT);
+  mcp.digitalWrite(15, LOW);
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 1), 0x00);
+  CHECK_EQ(simChips[0].get(MCP23XXX_IOCON) & (1 << 5), 0);
+}
+
+/*!
+    @brief  Fail the transfer after the current one.
+    @param chip simulated chip
+*/
+static void failNext(SimChip *chip) {
+  chip->failures = 1;
+  chip->wiring = nullptr;
+}
+
+TEST(stream_write_failures) {
+  Adafruit_MCP23X17 mcp;
+  const uint8_t values[3] = {0x01, 0x02, 0x03};
+  CHECK(simStart(&mcp, true));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  mcp.writeGPIOAB(0x8000);
+
+  // nothing to write, not even the other port's OLAT is read
+  mcp.enableCache(false);
+  uint32_t before = simTransactions();
+  CHECK(mcp.writeGPIOStream(values, 0));
+  CHECK_EQ(simTransactions() - before, 0);
+  mcp.enableCache(true);
+
+  CHECK(mcp.writeGPIOStream(values, 3));
+  CHECK_EQ(simChips[0].getOutputs(), 0x8003);
+
+  // a failed stream must not leave its last value in the cache
+  simChips[0].wiring = failNext;
+  CHECK(!mcp.writeGPIOStream(values, 2));
+  CHECK_EQ(simChips[0].get(MCP23XXX_IOCON) & (1 << 5), 0);
+  mcp.digitalWrite(1, LOW);
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 0), 0x01);
+}
+
+TEST(stream_write_other_port_read_fails) {
+  Adafruit_MCP23X17 mcp;
+  const uint8_t values[2] = {0x11, 0x22};
+  const uint16_t pairs[2] = {0x0102, 0x0304};
+  CHECK(simStart(&mcp));
+  mcp.pinModeMask(0xFFFF, OUTPUT);
+  mcp.writeGPIOAB(0x8000);
+
+  // nothing is written when Port B's latch cannot be read
+  simChips[0].failures = 1;
+  uint32_t before = simTransactions();
+  CHECK(!mcp.writeGPIOStream(values, 2));
+  CHECK_EQ(simTransactions() - before, 1);
+  CHECK_EQ(simChips[0].getOutputs(), 0x8000);
+
+  // a failed pair stream must not leave its last value in the cache
+  mcp.enableCache(true);
+  simChips[0].wiring = failNext;
+  CHECK(!mcp.writeGPIOABStream(pairs, 2));
+  mcp.digitalWrite(15, LOW);
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 0), 0x00);
+  CHECK_EQ(simChips[0].get(MCP23XXX_OLAT, 1), 0x00);
+}
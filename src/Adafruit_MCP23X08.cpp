@@ -25,8 +25,11 @@ void Adafruit_MCP23X08::enableAddrPins() {
   if (!spi_dev) // I2C dev always use addr, only makes sense for SPI dev
     return;
 
-  Adafruit_BusIO_Register GPIOAddr(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                   getRegister(MCP23XXX_IOCON, 0), 2);
+  uint8_t iocon = (1 << 3); // Bit3: HAEN
 
-  GPIOAddr.write((1 << 3), 1);
+  writeRegisters(MCP23XXX_IOCON, &iocon, 1);
+
+  // cache may have been loaded before the chip recognized its address
+  if (cacheEnabled)
+    refreshCache();
 }
\ No newline at end of file
@@ -4,6 +4,18 @@
 
 #include "Adafruit_MCP23X17.h"
 
+/*!
+    @brief  Stream sink storing 16 bit samples in a buffer.
+    @param context uint16_t sample buffer
+    @param index sample number
+    @param sample pin states
+    @return true
+*/
+static bool storeSample16(void *context, size_t index, uint16_t sample) {
+  ((uint16_t *)context)[index] = sample;
+  return true;
+}
+
 /**************************************************************************/
 /*!
   @brief default ctor.
@@ -50,9 +62,10 @@ void Adafruit_MCP23X17::writeGPIOB(uint8_t value) { writeGPIO(value, 1); }
 */
 /**************************************************************************/
 uint16_t Adafruit_MCP23X17::readGPIOAB() {
-  Adafruit_BusIO_Register GPIO(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPIO, 0), 2);
-  return GPIO.read();
+  uint8_t gpio[2] = {0, 0};
+
+  readRegisterBlock(MCP23XXX_GPIO, gpio, 1);
+  return gpio[0] | ((uint16_t)gpio[1] << 8);
 }
 
 /**************************************************************************/
@@ -62,9 +75,79 @@ uint16_t Adafruit_MCP23X17::readGPIOAB() {
 */
 /**************************************************************************/
 void Adafruit_MCP23X17::writeGPIOAB(uint16_t value) {
-  Adafruit_BusIO_Register GPIO(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPIO, 0), 2);
-  GPIO.write(value, 2);
+  uint8_t gpio[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+
+  writeRegisterBlock(MCP23XXX_GPIO, gpio, 1);
+}
+
+/**************************************************************************/
+/*!
+  @brief Write a sequence of values to Port A and Port B as fast as the bus
+  allows. Sequential addressing is turned off so the chip toggles its
+  address pointer between GPIOA and GPIOB, and values are sent back to back
+  in as few transactions as the bus buffer allows. With BANK=1 the ports
+  are not adjacent and each value takes one transaction per port.
+  @param values pin states to write in order, as uint16_t.
+  @param count number of values
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17::writeGPIOABStream(const uint16_t *values,
+                                          size_t count) {
+  uint8_t chunk[MCP23XXX_STREAM_CHUNK];
+  uint8_t max = streamChunk() & ~1;
+  bool ok;
+
+  if (!count)
+    return true;
+  if (regBank) {
+    ok = true;
+    for (size_t i = 0; ok && i < count; i++) {
+      chunk[0] = values[i] & 0xFF;
+      chunk[1] = values[i] >> 8;
+      ok = writeRegisterBlock(MCP23XXX_GPIO, chunk, 1);
+    }
+    return ok;
+  }
+  if (!setSequential(false))
+    return false;
+
+  // the cache assumes sequential addressing, update it afterwards
+  bool cached = pauseCache();
+  ok = true;
+  for (size_t i = 0; ok && i < count;) {
+    uint8_t len = 0;
+    while (len < max && i < count) {
+      chunk[len++] = values[i] & 0xFF;
+      chunk[len++] = values[i++] >> 8;
+    }
+    ok = writeRegisters(MCP23XXX_GPIO, chunk, len);
+  }
+  resumeCache(cached);
+  if (ok && cacheEntry(MCP23XXX_OLAT, 0)) {
+    *cacheEntry(MCP23XXX_OLAT, 0) = values[count - 1] & 0xFF;
+    *cacheEntry(MCP23XXX_OLAT, 1) = values[count - 1] >> 8;
+  }
+
+  return setSequential(true) && ok;
+}
+
+/**************************************************************************/
+/*!
+  @brief Sample Port A and Port B continuously, as fast as the bus allows.
+  Sequential addressing is turned off so the chip toggles its address
+  pointer between GPIOA and GPIOB, and every pair of bytes read in a
+  transaction is a new sample. With BANK=1 each sample takes one
+  transaction per port.
+  @param samples buffer to fill with count samples
+  @param count number of samples to take
+  @param rate if not nullptr, set to the effective sample rate in Hz
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17::readGPIOABStream(uint16_t *samples, size_t count,
+                                         uint32_t *rate) {
+  return readStream(0, true, count, storeSample16, samples, rate);
 }
 
 /**************************************************************************/
@@ -84,17 +167,60 @@ void Adafruit_MCP23X17::enableAddrPins() {
   if (!spi_dev) // I2C dev always use addr, only makes sense for SPI dev
     return;
 
-  Adafruit_BusIO_Register GPIOAddr(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                   getRegister(MCP23XXX_IOCON, 0), 2);
+  uint8_t iocon = (1 << 3) | (regBank << 7); // Bit3: HAEN, keep BANK
 
   // Send message to address 0b000 regardless of chip addr,
   // Because addressing is not yet enabled
   uint8_t tmp = this->hw_addr;
   this->hw_addr = 0; // Temporary set hw addr to 0
-  Adafruit_BusIO_Register GPIONoAddr(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                     getRegister(MCP23XXX_IOCON, 0), 2);
+  writeRegisters(MCP23XXX_IOCON, &iocon, 1); // devices with A2 = 0
   this->hw_addr = tmp;
 
-  GPIONoAddr.write((1 << 3), 1); // Bit3: HAEN, devices with A2 = 0
-  GPIOAddr.write((1 << 3), 1);   // Devices with A2 = 1 (if any)
-}
\ No newline at end of file
+  writeRegisters(MCP23XXX_IOCON, &iocon, 1); // Devices with A2 = 1 (if any)
+
+  // cache may have been loaded before the chip recognized its address
+  if (cacheEnabled)
+    refreshCache();
+}
+
+/**************************************************************************/
+/*!
+  @brief Select the register layout (IOCON.BANK). With BANK=0, the power-on
+  default, Port A and Port B registers are interleaved. With BANK=1 each
+  port has its own contiguous block, so readPortRegisters() and
+  writePortRegisters() take a single transaction that does not touch the
+  other port. All other functions work in either layout; those accessing
+  both ports use one transaction per port with BANK=1.
+
+  NOTE: The chip returns to BANK=0 on reset. begin_I2C()/begin_SPI() read
+  the layout the chip is in, so a chip left in BANK=1 keeps working after
+  a microcontroller reset.
+  @param bank 0 or 1
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17::setRegisterBank(uint8_t bank) {
+  uint8_t iocon;
+
+  bank = bank ? 1 : 0;
+  if (bank == regBank)
+    return true;
+  if (!readCachedRegister(MCP23XXX_IOCON, &iocon))
+    return false;
+
+  // written at the current address, the new layout applies right after
+  iocon = (iocon & ~(1 << 7)) | (bank << 7);
+  if (!writeRegisters(MCP23XXX_IOCON, &iocon, 1))
+    return false;
+  regBank = bank;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get the register layout (IOCON.BANK).
+  @returns 0 or 1
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23X17::getRegisterBank() { return regBank; }
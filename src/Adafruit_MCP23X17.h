@@ -22,7 +22,12 @@ public:
   void writeGPIOB(uint8_t value);
   uint16_t readGPIOAB();
   void writeGPIOAB(uint16_t value);
+  bool writeGPIOABStream(const uint16_t *values, size_t count);
+  bool readGPIOABStream(uint16_t *samples, size_t count,
+                        uint32_t *rate = nullptr);
   void enableAddrPins();
+  bool setRegisterBank(uint8_t bank);
+  uint8_t getRegisterBank();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*!
+ * @file Adafruit_MCP23X17_Async.cpp
+ */
+
+#include "Adafruit_MCP23X17_Async.h"
+
+#define ASYNC_READ_GPIOAB 0  //!< readGPIOAB() request
+#define ASYNC_WRITE_GPIOAB 1 //!< writeGPIOAB() request
+#define ASYNC_SERVICE_INT 2  //!< serviceInterrupt() request
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param mcp Pointer to initialized MCP23X17
+*/
+/**************************************************************************/
+Adafruit_MCP23X17_Async::Adafruit_MCP23X17_Async(Adafruit_MCP23X17 *mcp) {
+  this->mcp = mcp;
+}
+
+/**************************************************************************/
+/*!
+  @brief Queue a read of Port A and B. If the last queued request is a
+  read with the same callback, it is reused.
+  @param callback function called with the result
+  @return true if queued, false if the queue is full.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Async::readGPIOABAsync(MCP23XXX_ReadCallback callback) {
+  return enqueue(ASYNC_READ_GPIOAB, 0, (void (*)())callback, false);
+}
+
+/**************************************************************************/
+/*!
+  @brief Queue a write of Port A and B. If the last queued request is a
+  write, it is replaced by this one, and its callback is not called.
+  @param value pin states to write as uint16_t.
+  @param callback function called when the write is done, may be nullptr
+  @return true if queued, false if the queue is full.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Async::writeGPIOABAsync(
+    uint16_t value, MCP23XXX_WriteCallback callback) {
+  return enqueue(ASYNC_WRITE_GPIOAB, value, (void (*)())callback, true);
+}
+
+/**************************************************************************/
+/*!
+  @brief Queue a serviceInterrupt(). If the last queued request is the
+  same with the same callback, it is reused.
+  @param callback function called with the result
+  @return true if queued, false if the queue is full.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Async::serviceInterruptAsync(
+    MCP23XXX_InterruptCallback callback) {
+  return enqueue(ASYNC_SERVICE_INT, 0, (void (*)())callback, false);
+}
+
+/**************************************************************************/
+/*!
+  @brief Run the oldest queued transfer and call its callback. Call this
+  from loop(), or when the bus becomes free.
+  @return true if a transfer was run, false if the queue was empty.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Async::poll() {
+  if (!count)
+    return false;
+
+  // remove before running, so callbacks may queue new requests
+  Request req = queue[head];
+  head = (head + 1) % MCP23XXX_ASYNC_QUEUE_SIZE;
+  count--;
+
+  Adafruit_MCP23XXX *dev = mcp;
+  uint8_t gpio[2] = {0, 0};
+  bool ok;
+
+  switch (req.type) {
+  case ASYNC_READ_GPIOAB:
+    ok = dev->readRegisterBlock(MCP23XXX_GPIO, gpio, 1);
+    if (req.callback)
+      ((MCP23XXX_ReadCallback)req.callback)(ok, gpio[0] | (gpio[1] << 8));
+    break;
+  case ASYNC_WRITE_GPIOAB:
+    gpio[0] = req.value & 0xFF;
+    gpio[1] = req.value >> 8;
+    ok = dev->writeRegisterBlock(MCP23XXX_GPIO, gpio, 1);
+    if (req.callback)
+      ((MCP23XXX_WriteCallback)req.callback)(ok);
+    break;
+  case ASYNC_SERVICE_INT: {
+    MCP23XXX_Interrupt irq;
+    ok = dev->serviceInterrupt(&irq);
+    if (req.callback)
+      ((MCP23XXX_InterruptCallback)req.callback)(ok, irq.flags, irq.captured);
+    break;
+  }
+  }
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Number of queued transfers.
+  @returns transfers waiting for poll()
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23X17_Async::pending() { return count; }
+
+/**************************************************************************/
+/*!
+  @brief Add a request to the queue, merging with the last queued request
+  if it has the same type.
+  @param type request type
+  @param value value to write
+  @param callback completion callback
+  @param merge true to merge regardless of callback
+  @return true if queued or merged, false if the queue is full.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Async::enqueue(uint8_t type, uint16_t value,
+                                      void (*callback)(), bool merge) {
+  // only the last request can be merged, so transfers stay in order
+  if (count) {
+    Request *req = &queue[(head + count - 1) % MCP23XXX_ASYNC_QUEUE_SIZE];
+    if (req->type == type && (merge || req->callback == callback)) {
+      req->value = value;
+      req->callback = callback;
+      return true;
+    }
+  }
+
+  if (count == MCP23XXX_ASYNC_QUEUE_SIZE)
+    return false;
+
+  Request *req = &queue[(head + count) % MCP23XXX_ASYNC_QUEUE_SIZE];
+  req->type = type;
+  req->value = value;
+  req->callback = callback;
+  count++;
+
+  return true;
+}
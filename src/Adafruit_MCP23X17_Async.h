@@ -0,0 +1,68 @@
+/*!
+ * @file Adafruit_MCP23X17_Async.h
+ */
+
+#ifndef __ADAFRUIT_MCP23X17_ASYNC_H__
+#define __ADAFRUIT_MCP23X17_ASYNC_H__
+
+#include "Adafruit_MCP23X17.h"
+
+#define MCP23XXX_ASYNC_QUEUE_SIZE 8 //!< Maximum queued transfers
+
+/*!
+    @brief  Completion callback for a port read.
+    @param ok true if the transfer succeeded
+    @param value pin states, bit 0 is pin 0
+*/
+typedef void (*MCP23XXX_ReadCallback)(bool ok, uint16_t value);
+
+/*!
+    @brief  Completion callback for a port write.
+    @param ok true if the transfer succeeded
+*/
+typedef void (*MCP23XXX_WriteCallback)(bool ok);
+
+/*!
+    @brief  Completion callback for interrupt servicing.
+    @param ok true if the transfer succeeded
+    @param flags pins that caused the interrupt
+    @param captured pin states at time of interrupt
+*/
+typedef void (*MCP23XXX_InterruptCallback)(bool ok, uint16_t flags,
+                                           uint16_t captured);
+
+/**************************************************************************/
+/*!
+    @brief  Queues MCP23X17 transfers so they can be run later from poll(),
+    one transfer per call, instead of blocking the caller. Back to back
+    writes are merged, only the latest value is sent.
+*/
+/**************************************************************************/
+class Adafruit_MCP23X17_Async {
+public:
+  Adafruit_MCP23X17_Async(Adafruit_MCP23X17 *mcp);
+
+  bool readGPIOABAsync(MCP23XXX_ReadCallback callback);
+  bool writeGPIOABAsync(uint16_t value,
+                        MCP23XXX_WriteCallback callback = nullptr);
+  bool serviceInterruptAsync(MCP23XXX_InterruptCallback callback);
+
+  bool poll();
+  uint8_t pending();
+
+private:
+  typedef struct {
+    uint8_t type;
+    uint16_t value;
+    void (*callback)();
+  } Request;
+
+  Adafruit_MCP23X17 *mcp;
+  Request queue[MCP23XXX_ASYNC_QUEUE_SIZE];
+  uint8_t head = 0;
+  uint8_t count = 0;
+
+  bool enqueue(uint8_t type, uint16_t value, void (*callback)(), bool merge);
+};
+
+#endif
@@ -0,0 +1,201 @@
+/*!
+ * @file Adafruit_MCP23X17_Bank.h
+ */
+
+#ifndef __ADAFRUIT_MCP23X17_BANK_H__
+#define __ADAFRUIT_MCP23X17_BANK_H__
+
+#include "Adafruit_MCP23X17.h"
+
+/**************************************************************************/
+/*!
+    @brief  Group of N MCP23X17 chips sharing one bus, addressed as a single
+    virtual port of N * 16 pins. Pin p is pin (p % 16) of chip (p / 16).
+    Pins from N * 16 up are ignored, and read as LOW.
+    @tparam N number of chips, at most 8
+*/
+/**************************************************************************/
+template <uint8_t N> class Adafruit_MCP23X17_Bank {
+  static_assert(N > 0 && N <= 8, "MCP23X17 bank supports 1 to 8 chips");
+
+public:
+  /**************************************************************************/
+  /*!
+    @brief Initialize all chips on I2C, at consecutive addresses. The
+    output images are loaded from the chips, outputs are not changed.
+    @param i2c_addr I2C address of first chip
+    @param wire Pointer to Wire instance
+    @return true if all chips were found, otherwise false.
+  */
+  /**************************************************************************/
+  bool begin_I2C(uint8_t i2c_addr = MCP23XXX_ADDR, TwoWire *wire = &Wire) {
+    for (uint8_t i = 0; i < N; i++) {
+      if (!chips[i].begin_I2C(i2c_addr + i, wire))
+        return false;
+    }
+    return loadOutputs();
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Initialize all chips on hardware SPI, sharing one chip select.
+    Chip i must have its A2/A1/A0 pins set to i. HW addressing is enabled.
+    The output images are loaded from the chips, outputs are not changed.
+    @param cs_pin Pin to use for SPI chip select
+    @param theSPI Pointer to SPI instance
+    @return true if successful, otherwise false.
+  */
+  /**************************************************************************/
+  bool begin_SPI(uint8_t cs_pin, SPIClass *theSPI = &SPI) {
+    for (uint8_t i = 0; i < N; i++) {
+      if (!chips[i].begin_SPI(cs_pin, theSPI, i))
+        return false;
+    }
+    // the last chip also reaches A2 = 1 devices (see enableAddrPins)
+    chips[N - 1].enableAddrPins();
+    return loadOutputs();
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Access a single chip of the bank.
+    @param index chip number, 0 to N - 1
+    @returns reference to chip
+  */
+  /**************************************************************************/
+  Adafruit_MCP23X17 &chip(uint8_t index) { return chips[index]; }
+
+  /**************************************************************************/
+  /*!
+    @brief Total number of pins in the bank.
+    @returns N * 16
+  */
+  /**************************************************************************/
+  uint16_t pinCount() { return N * 16; }
+
+  /**************************************************************************/
+  /*!
+    @brief Configures the specified virtual pin.
+    @param pin virtual pin number
+    @param mode INPUT, OUTPUT, or INPUT_PULLUP
+  */
+  /**************************************************************************/
+  void pinMode(uint16_t pin, uint8_t mode) {
+    if (pin >= N * 16)
+      return;
+    chips[pin / 16].pinMode(pin % 16, mode);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Reads the specified virtual pin.
+    @param pin virtual pin number
+    @returns HIGH or LOW, LOW for pins outside the bank
+  */
+  /**************************************************************************/
+  uint8_t digitalRead(uint16_t pin) {
+    if (pin >= N * 16)
+      return LOW;
+    return chips[pin / 16].digitalRead(pin % 16);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Write the specified virtual pin. Only the owning chip is written,
+    and only if its output image changed.
+    @param pin virtual pin number
+    @param value HIGH or LOW
+  */
+  /**************************************************************************/
+  void digitalWrite(uint16_t pin, uint8_t value) {
+    if (pin >= N * 16)
+      return;
+    setPin(pin, value);
+    flushChip(pin / 16);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Change a virtual pin in the output image without writing it.
+    Use flush() to write all changed chips.
+    @param pin virtual pin number
+    @param value HIGH or LOW
+  */
+  /**************************************************************************/
+  void setPin(uint16_t pin, uint8_t value) {
+    if (pin >= N * 16)
+      return;
+    uint8_t index = pin / 16;
+    uint16_t bit = (uint16_t)1 << (pin % 16);
+    uint16_t image = (value == LOW) ? (outputs[index] & ~bit)
+                                    : (outputs[index] | bit);
+
+    if (image != outputs[index]) {
+      outputs[index] = image;
+      dirty |= 1 << index;
+    }
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Write the output images of all chips that changed, one
+    transaction per changed chip.
+  */
+  /**************************************************************************/
+  void flush() {
+    for (uint8_t i = 0; i < N; i++)
+      flushChip(i);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Set all outputs of the bank and write the chips that changed.
+    @param values N port values, one uint16_t per chip
+  */
+  /**************************************************************************/
+  void writeAll(const uint16_t *values) {
+    for (uint8_t i = 0; i < N; i++) {
+      if (values[i] != outputs[i]) {
+        outputs[i] = values[i];
+        dirty |= 1 << i;
+      }
+    }
+    flush();
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief Read all inputs of the bank, one transaction per chip.
+    @param values buffer for N port values, one uint16_t per chip
+  */
+  /**************************************************************************/
+  void readAll(uint16_t *values) {
+    for (uint8_t i = 0; i < N; i++)
+      values[i] = chips[i].readGPIOAB();
+  }
+
+private:
+  Adafruit_MCP23X17 chips[N];
+  uint16_t outputs[N] = {};
+  uint8_t dirty = 0;
+
+  bool loadOutputs() {
+    for (uint8_t i = 0; i < N; i++) {
+      uint8_t olat[2] = {0, 0};
+      if (!chips[i].readRegisterBlock(MCP23XXX_OLAT, olat, 1))
+        return false;
+      outputs[i] = olat[0] | ((uint16_t)olat[1] << 8);
+    }
+    dirty = 0;
+    return true;
+  }
+
+  void flushChip(uint8_t index) {
+    if (dirty & (1 << index)) {
+      chips[index].writeGPIOAB(outputs[index]);
+      dirty &= ~(1 << index);
+    }
+  }
+};
+
+#endif
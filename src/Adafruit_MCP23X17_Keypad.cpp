@@ -0,0 +1,172 @@
+/*!
+ * @file Adafruit_MCP23X17_Keypad.cpp
+ */
+
+#include "Adafruit_MCP23X17_Keypad.h"
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param mcp Pointer to initialized MCP23X17
+  @param rows number of rows, on GPA0 and up
+  @param cols number of columns, on GPB0 and up
+  @param int_pin microcontroller pin attached to INTB (or mirrored INTA/B),
+  or -1 to check the interrupt flags over the bus instead
+*/
+/**************************************************************************/
+Adafruit_MCP23X17_Keypad::Adafruit_MCP23X17_Keypad(Adafruit_MCP23X17 *mcp,
+                                                   uint8_t rows, uint8_t cols,
+                                                   int8_t int_pin) {
+  this->mcp = mcp;
+  this->rows = (rows > 8) ? 8 : rows;
+  this->rowMask = (1 << this->rows) - 1;
+  this->colMask = (1 << ((cols > 8) ? 8 : cols)) - 1;
+  this->int_pin = int_pin;
+}
+
+/**************************************************************************/
+/*!
+  @brief Configure the chip for scanning. All rows are driven LOW while
+  idle, so any key press triggers an interrupt-on-change on its column.
+  Only the row and column pins are changed, other pins keep their setup.
+  @param driveIODIR true (default) to drive only the active row and leave
+  the others floating, which is safe for matrices without diodes when
+  several keys are held. false to drive rows as push-pull outputs; this
+  needs a diode on every key, otherwise two keys held in one column short a
+  HIGH row to a LOW one.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::begin(bool driveIODIR) {
+  Adafruit_MCP23XXX *dev = mcp;
+  uint16_t cols = (uint16_t)colMask << 8;
+
+  this->driveIODIR = driveIODIR;
+  keys = 0;
+  ghost = false;
+
+  // rows LOW, columns inputs with pull-ups and interrupt-on-change
+  if (!dev->updateRegisterPorts(MCP23XXX_OLAT, rowMask, 0) ||
+      !dev->updateRegisterPorts(MCP23XXX_IODIR, rowMask | cols, cols) ||
+      !dev->updateRegisterPorts(MCP23XXX_IPOL, cols, 0) ||
+      !dev->updateRegisterPorts(MCP23XXX_INTCON, cols, 0) ||
+      !dev->updateRegisterPorts(MCP23XXX_GPPU, cols, cols) ||
+      !dev->updateRegisterPorts(MCP23XXX_GPINTEN, cols, cols))
+    return false;
+  dev->clearInterrupts();
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Scan the matrix if a key could have changed. While no key is held
+  nothing is scanned until the columns signal an interrupt.
+  @return true if the key bitmap changed, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::update() {
+  if (!keys && !keyActivity())
+    return false;
+  return scan();
+}
+
+/**************************************************************************/
+/*!
+  @brief Scan all rows now. If a transfer fails the key bitmap is kept.
+  @return true if the key bitmap changed, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::scan() {
+  uint8_t pressed[8];
+  uint8_t cols;
+  uint64_t now = 0;
+  bool ok = true;
+
+  for (uint8_t row = 0; ok && row < rows; row++) {
+    // active row LOW, pressed keys pull their column LOW
+    ok = driveRow(~(1 << row) & rowMask, &cols);
+    pressed[row] = ~cols & colMask;
+    now |= (uint64_t)pressed[row] << (8 * row);
+  }
+
+  // back to idle, reading the columns also clears the interrupt
+  if (!driveRow(0, &cols) || !ok)
+    return false;
+
+  // a key is ambiguous if two rows share two or more pressed columns
+  ghost = false;
+  for (uint8_t i = 0; i < rows; i++) {
+    for (uint8_t j = i + 1; j < rows; j++) {
+      uint8_t common = pressed[i] & pressed[j];
+      if (common & (common - 1))
+        ghost = true;
+    }
+  }
+
+  bool changed = (now != keys);
+  keys = now;
+  return changed;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get all pressed keys.
+  @returns key bitmap, bit (row * 8 + col) set for each pressed key
+*/
+/**************************************************************************/
+uint64_t Adafruit_MCP23X17_Keypad::getKeys() { return keys; }
+
+/**************************************************************************/
+/*!
+  @brief Check a single key from the last scan.
+  @param row key row
+  @param col key column
+  @returns true if pressed
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::isPressed(uint8_t row, uint8_t col) {
+  return (keys >> (row * 8 + col)) & 1;
+}
+
+/**************************************************************************/
+/*!
+  @brief Check if the last scan may contain ghost keys, caused by three or
+  more keys held at the corners of a rectangle.
+  @returns true if the key bitmap is ambiguous
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::ghosting() { return ghost; }
+
+/**************************************************************************/
+/*!
+  @brief Check for column activity while idle.
+  @returns true if a column interrupt is pending
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::keyActivity() {
+  if (int_pin >= 0)
+    return digitalRead(int_pin) == LOW;
+
+  Adafruit_MCP23XXX *dev = mcp;
+  return dev->readRegister(MCP23XXX_INTF, 1) & colMask;
+}
+
+/**************************************************************************/
+/*!
+  @brief Drive the rows and read the columns. Other Port A pins are not
+  changed; with the register cache enabled this is one write and one read.
+  @param value row levels, LOW bits are driven LOW
+  @param cols set to the column levels, all HIGH on error
+  @returns true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23X17_Keypad::driveRow(uint8_t value, uint8_t *cols) {
+  Adafruit_MCP23XXX *dev = mcp;
+  // with driveIODIR only the LOW rows are outputs, latched LOW by begin()
+  uint8_t reg = driveIODIR ? MCP23XXX_IODIR : MCP23XXX_OLAT;
+
+  *cols = 0xFF;
+  return dev->updateRegister(reg, rowMask, value, 0) &&
+         dev->readRegisters(MCP23XXX_GPIO, cols, 1, 1);
+}
@@ -0,0 +1,46 @@
+/*!
+ * @file Adafruit_MCP23X17_Keypad.h
+ */
+
+#ifndef __ADAFRUIT_MCP23X17_KEYPAD_H__
+#define __ADAFRUIT_MCP23X17_KEYPAD_H__
+
+#include "Adafruit_MCP23X17.h"
+
+/**************************************************************************/
+/*!
+    @brief  Key matrix scanner for one MCP23X17. Rows are on Port A and
+    columns on Port B, with the column pull-ups enabled. Key (row, col) is
+    bit (row * 8 + col) of the key bitmap. By default only the active row
+    is driven, which is safe without diodes; begin(false) scans faster but
+    needs a diode on every key if several keys can be held.
+*/
+/**************************************************************************/
+class Adafruit_MCP23X17_Keypad {
+public:
+  Adafruit_MCP23X17_Keypad(Adafruit_MCP23X17 *mcp, uint8_t rows = 8,
+                           uint8_t cols = 8, int8_t int_pin = -1);
+
+  bool begin(bool driveIODIR = true);
+  bool update();
+  bool scan();
+
+  uint64_t getKeys();
+  bool isPressed(uint8_t row, uint8_t col);
+  bool ghosting();
+
+private:
+  Adafruit_MCP23X17 *mcp;
+  uint8_t rows;
+  uint8_t rowMask;
+  uint8_t colMask;
+  int8_t int_pin;
+  bool driveIODIR = true;
+  bool ghost = false;
+  uint64_t keys = 0;
+
+  bool keyActivity();
+  bool driveRow(uint8_t value, uint8_t *cols);
+};
+
+#endif
@@ -22,6 +22,66 @@
 
 #include "Adafruit_MCP23XXX.h"
 
+#ifdef __AVR__
+#include <new.h> // placement new
+#else
+#include <new>
+#endif
+
+/*!
+    @brief  Destination of readGPIOChanges().
+*/
+typedef struct {
+  MCP23XXX_Run *runs; ///< Run buffer
+  size_t maxRuns;     ///< Size of run buffer
+  size_t count;       ///< Runs stored
+} RunBuffer;
+
+/*!
+    @brief  Stream sink storing 8 bit samples in a buffer.
+    @param context uint8_t sample buffer
+    @param index sample number
+    @param sample pin states
+    @return true
+*/
+static bool storeSample8(void *context, size_t index, uint16_t sample) {
+  ((uint8_t *)context)[index] = sample;
+  return true;
+}
+
+/*!
+    @brief  Stream sink storing runs of equal samples.
+    @param context RunBuffer
+    @param index sample number
+    @param sample pin states
+    @return false when the run buffer is full
+*/
+static bool storeRun(void *context, size_t index, uint16_t sample) {
+  RunBuffer *buf = (RunBuffer *)context;
+
+  (void)index;
+  if (buf->count) {
+    MCP23XXX_Run *last = &buf->runs[buf->count - 1];
+    if (last->value == sample && last->length < 0xFFFF) {
+      last->length++;
+      return true;
+    }
+  }
+  if (buf->count == buf->maxRuns)
+    return false;
+  buf->runs[buf->count].value = sample;
+  buf->runs[buf->count].length = 1;
+  buf->count++;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief dtor. Destroys the bus interface.
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX::~Adafruit_MCP23XXX() { releaseDevices(); }
+
 /**************************************************************************/
 /*!
   @brief Initialize MCP using I2C.
@@ -31,25 +91,43 @@
 */
 /**************************************************************************/
 bool Adafruit_MCP23XXX::begin_I2C(uint8_t i2c_addr, TwoWire *wire) {
-  i2c_dev = new Adafruit_I2CDevice(i2c_addr, wire);
-  return i2c_dev->begin();
+  releaseDevices();
+  busClock = 0; // whatever Wire is set to
+#ifndef MCP23XXX_NO_SPI
+  spi_cs = -1;
+  spi_bus = nullptr;
+#endif
+  i2c_dev = new (busStorage) Adafruit_I2CDevice(i2c_addr, wire);
+  regBank = 0; // power-on default
+  if (!i2c_dev->begin() || !detectRegisterBank())
+    return false;
+  return cacheEnabled ? refreshCache() : true;
 }
 
+#ifndef MCP23XXX_NO_SPI
 /**************************************************************************/
 /*!
   @brief Initialize MCP using hardware SPI.
   @param cs_pin Pin to use for SPI chip select
   @param theSPI Pointer to SPI instance
   @param _hw_addr Hardware address (pins A2, A1, A0)
+  @param freq SPI clock frequency, up to 10MHz
   @return true if initialization successful, otherwise false.
 */
 /**************************************************************************/
 bool Adafruit_MCP23XXX::begin_SPI(uint8_t cs_pin, SPIClass *theSPI,
-                                  uint8_t _hw_addr) {
+                                  uint8_t _hw_addr, uint32_t freq) {
+  releaseDevices();
   this->hw_addr = _hw_addr;
-  spi_dev = new Adafruit_SPIDevice(cs_pin, 1000000, SPI_BITORDER_MSBFIRST,
-                                   SPI_MODE0, theSPI);
-  return spi_dev->begin();
+  spi_cs = cs_pin;
+  spi_bus = theSPI;
+  busClock = freq;
+  spi_dev = new (busStorage) Adafruit_SPIDevice(
+      cs_pin, freq, SPI_BITORDER_MSBFIRST, SPI_MODE0, theSPI);
+  regBank = 0; // power-on default
+  if (!spi_dev->begin() || !detectRegisterBank())
+    return false;
+  return cacheEnabled ? refreshCache() : true;
 }
 
 /**************************************************************************/
@@ -66,10 +144,19 @@ bool Adafruit_MCP23XXX::begin_SPI(uint8_t cs_pin, SPIClass *theSPI,
 bool Adafruit_MCP23XXX::begin_SPI(int8_t cs_pin, int8_t sck_pin,
                                   int8_t miso_pin, int8_t mosi_pin,
                                   uint8_t _hw_addr) {
+  releaseDevices();
   this->hw_addr = _hw_addr;
-  spi_dev = new Adafruit_SPIDevice(cs_pin, sck_pin, miso_pin, mosi_pin);
-  return spi_dev->begin();
+  busClock = 0; // software SPI runs as fast as it can
+  spi_cs = cs_pin;
+  spi_bus = nullptr; // setBusClock() only rebuilds hardware SPI devices
+  spi_dev = new (busStorage)
+      Adafruit_SPIDevice(cs_pin, sck_pin, miso_pin, mosi_pin);
+  regBank = 0; // power-on default
+  if (!spi_dev->begin() || !detectRegisterBank())
+    return false;
+  return cacheEnabled ? refreshCache() : true;
 }
+#endif
 
 /**************************************************************************/
 /*!
@@ -80,15 +167,12 @@ bool Adafruit_MCP23XXX::begin_SPI(int8_t cs_pin, int8_t sck_pin,
 */
 /**************************************************************************/
 void Adafruit_MCP23XXX::pinMode(uint8_t pin, uint8_t mode) {
-  Adafruit_BusIO_Register IODIR(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                getRegister(MCP23XXX_IODIR, MCP_PORT(pin)));
-  Adafruit_BusIO_Register GPPU(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPPU, MCP_PORT(pin)));
-  Adafruit_BusIO_RegisterBits dir_bit(&IODIR, 1, pin % 8);
-  Adafruit_BusIO_RegisterBits pullup_bit(&GPPU, 1, pin % 8);
+  uint8_t bit = 1 << (pin % 8);
 
-  dir_bit.write((mode == OUTPUT) ? 0 : 1);
-  pullup_bit.write((mode == INPUT_PULLUP) ? 1 : 0);
+  updateRegister(MCP23XXX_IODIR, bit, (mode == OUTPUT) ? 0 : bit,
+                 MCP_PORT(pin));
+  updateRegister(MCP23XXX_GPPU, bit, (mode == INPUT_PULLUP) ? bit : 0,
+                 MCP_PORT(pin));
 }
 
 /**************************************************************************/
@@ -99,26 +183,31 @@ void Adafruit_MCP23XXX::pinMode(uint8_t pin, uint8_t mode) {
 */
 /**************************************************************************/
 uint8_t Adafruit_MCP23XXX::digitalRead(uint8_t pin) {
-  Adafruit_BusIO_Register GPIO(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPIO, MCP_PORT(pin)));
-  Adafruit_BusIO_RegisterBits pin_bit(&GPIO, 1, pin % 8);
+  uint8_t gpio = readRegister(MCP23XXX_GPIO, MCP_PORT(pin));
 
-  return ((pin_bit.read() == 0) ? LOW : HIGH);
+  return ((gpio & (1 << (pin % 8))) == 0) ? LOW : HIGH;
 }
 
 /**************************************************************************/
 /*!
-  @brief Write a HIGH or a LOW value to a digital pin.
+  @brief Write a HIGH or a LOW value to a digital pin. The output latch
+  (OLAT) is modified rather than GPIO, so input levels on other pins of the
+  port are never latched into their outputs.
   @param pin the Arduino pin number
   @param value HIGH or LOW
 */
 /**************************************************************************/
 void Adafruit_MCP23XXX::digitalWrite(uint8_t pin, uint8_t value) {
-  Adafruit_BusIO_Register GPIO(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPIO, MCP_PORT(pin)));
-  Adafruit_BusIO_RegisterBits pin_bit(&GPIO, 1, pin % 8);
+  uint8_t bit = 1 << (pin % 8);
 
-  pin_bit.write((value == LOW) ? 0 : 1);
+#ifndef MCP23XXX_NO_CACHE
+  if (batchActive) {
+    digitalWriteMask((uint16_t)1 << pin, (value == LOW) ? 0 : 0xFFFF);
+    return;
+  }
+#endif
+
+  updateRegister(MCP23XXX_OLAT, bit, (value == LOW) ? 0 : bit, MCP_PORT(pin));
 }
 
 /**************************************************************************/
@@ -129,9 +218,7 @@ void Adafruit_MCP23XXX::digitalWrite(uint8_t pin, uint8_t value) {
 */
 /**************************************************************************/
 uint8_t Adafruit_MCP23XXX::readGPIO(uint8_t port) {
-  Adafruit_BusIO_Register GPIO(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPIO, port));
-  return GPIO.read() & 0xFF;
+  return readRegister(MCP23XXX_GPIO, port);
 }
 
 /**************************************************************************/
@@ -142,9 +229,174 @@ uint8_t Adafruit_MCP23XXX::readGPIO(uint8_t port) {
 */
 /**************************************************************************/
 void Adafruit_MCP23XXX::writeGPIO(uint8_t value, uint8_t port) {
-  Adafruit_BusIO_Register GPIO(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                               getRegister(MCP23XXX_GPIO, port));
-  GPIO.write(value);
+  writeRegisters(MCP23XXX_GPIO, &value, 1, port);
+}
+
+/**************************************************************************/
+/*!
+  @brief Configure several pins at once. Each register is updated for both
+  ports in a single transaction (one per port with BANK=1).
+  @param mask bit mask of pins to configure, bit 0 is pin 0.
+  @param mode INPUT, OUTPUT, or INPUT_PULLUP
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::pinModeMask(uint16_t mask, uint8_t mode) {
+  updateRegisterPorts(MCP23XXX_IODIR, mask, (mode == OUTPUT) ? 0 : 0xFFFF);
+  updateRegisterPorts(MCP23XXX_GPPU, mask, (mode == INPUT_PULLUP) ? 0xFFFF : 0);
+}
+
+/**************************************************************************/
+/*!
+  @brief Write several pins at once. Both ports are updated in a single
+  transaction. Inside a batch, only the pending port image is changed.
+  @param mask bit mask of pins to write, bit 0 is pin 0.
+  @param values pin states to write, bit 0 is pin 0.
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::digitalWriteMask(uint16_t mask, uint16_t values) {
+#ifndef MCP23XXX_NO_CACHE
+  if (batchActive) {
+    batchImage = (batchImage & ~mask) | (values & mask);
+    batchPorts |= ((mask & 0x00FF) ? 0x01 : 0) | ((mask & 0xFF00) ? 0x02 : 0);
+    return;
+  }
+#endif
+  updateRegisterPorts(MCP23XXX_OLAT, mask, values);
+}
+
+/**************************************************************************/
+/*!
+  @brief Start a batch of output changes. Until commit() is called,
+  digitalWrite() and digitalWriteMask() only modify an image of the output
+  latches held in RAM. Other calls go to the chip immediately.
+  @return true if the output latches were read, otherwise false and no
+  batch is started. Always false when built with MCP23XXX_NO_CACHE.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::beginBatch() {
+#ifdef MCP23XXX_NO_CACHE
+  return false;
+#else
+  uint8_t olat[2] = {regCache[0][MCP23XXX_OLAT], regCache[1][MCP23XXX_OLAT]};
+
+  if (!(cacheEnabled && isCached(MCP23XXX_OLAT)) &&
+      !readRegisterBlock(MCP23XXX_OLAT, olat, 1))
+    return false;
+  batchImage = olat[0] | ((uint16_t)olat[1] << 8);
+  batchPorts = 0;
+  batchActive = true;
+  return true;
+#endif
+}
+
+/**************************************************************************/
+/*!
+  @brief End a batch and write all changed output latches in a single
+  transaction. If the write fails the batch stays open, so commit() can be
+  called again.
+  @return true if successful, false if the write failed or no batch was
+  started.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::commit() {
+#ifdef MCP23XXX_NO_CACHE
+  return false;
+#else
+  if (!batchActive)
+    return false;
+  if (batchPorts && !writeRegisterPorts(MCP23XXX_OLAT, batchImage, batchPorts))
+    return false;
+  batchActive = false;
+  batchPorts = 0;
+  return true;
+#endif
+}
+
+/**************************************************************************/
+/*!
+  @brief Write a sequence of values to a port as fast as the bus allows.
+  Sequential addressing is turned off so the chip keeps its address pointer
+  on GPIO, and values are sent back to back in as few transactions as the
+  bus buffer allows. On MCP23X17 with BANK=0 the pointer toggles between
+  Port A and B, so the other port is rewritten with its current output
+  latch.
+  @param values port values to write in order
+  @param count number of values
+  @param port 0 for Port A, 1 for Port B (MCP23X17 only).
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writeGPIOStream(const uint8_t *values, size_t count,
+                                        uint8_t port) {
+  uint8_t chunk[MCP23XXX_STREAM_CHUNK];
+  bool pair = (pinCount > 8) && !regBank;
+  uint8_t max = pair ? (streamChunk() & ~1) : streamChunk();
+  uint8_t other = 0;
+  bool ok;
+
+  if (!count)
+    return true;
+  if (pair && !readRegisters(MCP23XXX_OLAT, &other, 1, port ^ 1))
+    return false;
+  if (!setSequential(false))
+    return false;
+
+  // the cache assumes sequential addressing, update it afterwards
+  bool cached = pauseCache();
+  ok = true;
+  for (size_t i = 0; ok && i < count;) {
+    uint8_t len = 0;
+    while (len < max && i < count) {
+      chunk[len++] = values[i++];
+      if (pair)
+        chunk[len++] = other;
+    }
+    ok = writeRegisters(MCP23XXX_GPIO, chunk, len, port);
+  }
+  resumeCache(cached);
+  uint8_t *olat = cacheEntry(MCP23XXX_OLAT, port);
+  if (ok && olat)
+    *olat = values[count - 1];
+
+  return setSequential(true) && ok;
+}
+
+/**************************************************************************/
+/*!
+  @brief Sample a port continuously, as fast as the bus allows. Sequential
+  addressing is turned off so every byte read in a transaction is a new
+  GPIO sample.
+  @param samples buffer to fill with count samples
+  @param count number of samples to take
+  @param port 0 for Port A, 1 for Port B (MCP23X17 only).
+  @param rate if not nullptr, set to the effective sample rate in Hz
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readGPIOStream(uint8_t *samples, size_t count,
+                                       uint8_t port, uint32_t *rate) {
+  return readStream(port, false, count, storeSample8, samples, rate);
+}
+
+/**************************************************************************/
+/*!
+  @brief Sample all pins continuously and keep only the changes, as runs of
+  equal samples. Long captures of slowly changing inputs stay small.
+  @param runs buffer for the runs
+  @param maxRuns size of runs buffer, the capture stops when it is full
+  @param count number of samples to take
+  @param rate if not nullptr, set to the effective sample rate in Hz
+  @returns number of runs stored
+*/
+/**************************************************************************/
+size_t Adafruit_MCP23XXX::readGPIOChanges(MCP23XXX_Run *runs, size_t maxRuns,
+                                          size_t count, uint32_t *rate) {
+  RunBuffer buf = {runs, maxRuns, 0};
+
+  if (!maxRuns)
+    return 0;
+  readStream(0, true, count, storeRun, &buf, rate);
+  return buf.count;
 }
 
 /**************************************************************************/
@@ -157,15 +409,11 @@ void Adafruit_MCP23XXX::writeGPIO(uint8_t value, uint8_t port) {
 /**************************************************************************/
 void Adafruit_MCP23XXX::setupInterrupts(bool mirroring, bool openDrain,
                                         uint8_t polarity) {
-  Adafruit_BusIO_Register IOCON(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                getRegister(MCP23XXX_IOCON));
-  Adafruit_BusIO_RegisterBits mirror_bit(&IOCON, 1, 6);
-  Adafruit_BusIO_RegisterBits openDrain_bit(&IOCON, 1, 2);
-  Adafruit_BusIO_RegisterBits polarity_bit(&IOCON, 1, 1);
+  uint8_t value = (mirroring ? (1 << 6) : 0) | (openDrain ? (1 << 2) : 0) |
+                  ((polarity == HIGH) ? (1 << 1) : 0);
 
-  mirror_bit.write(mirroring ? 1 : 0);
-  openDrain_bit.write(openDrain ? 1 : 0);
-  polarity_bit.write((polarity == HIGH) ? 1 : 0);
+  // MIRROR, ODR and INTPOL bits
+  updateRegister(MCP23XXX_IOCON, (1 << 6) | (1 << 2) | (1 << 1), value);
 }
 
 /**************************************************************************/
@@ -176,19 +424,13 @@ void Adafruit_MCP23XXX::setupInterrupts(bool mirroring, bool openDrain,
 */
 /**************************************************************************/
 void Adafruit_MCP23XXX::setupInterruptPin(uint8_t pin, uint8_t mode) {
-  Adafruit_BusIO_Register GPINTEN(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                  getRegister(MCP23XXX_GPINTEN, MCP_PORT(pin)));
-  Adafruit_BusIO_Register INTCON(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                 getRegister(MCP23XXX_INTCON, MCP_PORT(pin)));
-  Adafruit_BusIO_Register DEFVAL(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                 getRegister(MCP23XXX_DEFVAL, MCP_PORT(pin)));
-  Adafruit_BusIO_RegisterBits enable_bit(&GPINTEN, 1, pin % 8);
-  Adafruit_BusIO_RegisterBits config_bit(&INTCON, 1, pin % 8);
-  Adafruit_BusIO_RegisterBits defval_bit(&DEFVAL, 1, pin % 8);
+  uint8_t port = MCP_PORT(pin);
+  uint8_t bit = 1 << (pin % 8);
 
-  enable_bit.write(1);                        // enable it
-  config_bit.write((mode == CHANGE) ? 0 : 1); // set mode
-  defval_bit.write((mode == LOW) ? 1 : 0);    // set defval
+  // set mode and defval before enabling to avoid a spurious interrupt
+  updateRegister(MCP23XXX_INTCON, bit, (mode == CHANGE) ? 0 : bit, port);
+  updateRegister(MCP23XXX_DEFVAL, bit, (mode == LOW) ? bit : 0, port);
+  updateRegister(MCP23XXX_GPINTEN, bit, bit, port); // enable it
 }
 
 /**************************************************************************/
@@ -198,11 +440,7 @@ void Adafruit_MCP23XXX::setupInterruptPin(uint8_t pin, uint8_t mode) {
 */
 /**************************************************************************/
 void Adafruit_MCP23XXX::disableInterruptPin(uint8_t pin) {
-  Adafruit_BusIO_Register GPINTEN(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                  getRegister(MCP23XXX_GPINTEN, MCP_PORT(pin)));
-  Adafruit_BusIO_RegisterBits enable_bit(&GPINTEN, 1, pin % 8);
-
-  enable_bit.write(0);
+  updateRegister(MCP23XXX_GPINTEN, 1 << (pin % 8), 0, MCP_PORT(pin));
 }
 
 /**************************************************************************/
@@ -225,27 +463,11 @@ void Adafruit_MCP23XXX::clearInterrupts() {
 */
 /**************************************************************************/
 uint8_t Adafruit_MCP23XXX::getLastInterruptPin() {
-  uint8_t intf;
-
-  // Port A
-  Adafruit_BusIO_Register INTFA(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                getRegister(MCP23XXX_INTF, 0));
-  INTFA.read(&intf);
-  for (uint8_t pin = 0; pin < 8; pin++) {
-    if (intf & (1 << pin)) {
-      return pin;
-    }
-  }
+  uint16_t intf = readRegisterPorts(MCP23XXX_INTF);
 
-  // Port B ?
-  if (pinCount > 8) {
-    Adafruit_BusIO_Register INTFB(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                  getRegister(MCP23XXX_INTF, 1));
-    INTFB.read(&intf);
-    for (uint8_t pin = 0; pin < 8; pin++) {
-      if (intf & (1 << pin)) {
-        return pin + 8;
-      }
+  for (uint8_t pin = 0; pin < pinCount; pin++) {
+    if (intf & ((uint16_t)1 << pin)) {
+      return pin;
     }
   }
 
@@ -259,24 +481,93 @@ uint8_t Adafruit_MCP23XXX::getLastInterruptPin() {
 */
 /**************************************************************************/
 uint16_t Adafruit_MCP23XXX::getCapturedInterrupt() {
-  uint16_t intcap;
-  uint8_t intf;
+  return readRegisterPorts(MCP23XXX_INTCAP);
+}
 
-  // Port A
-  Adafruit_BusIO_Register INTCAPA(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                  getRegister(MCP23XXX_INTCAP, 0));
-  INTCAPA.read(&intf);
-  intcap = intf;
+/**************************************************************************/
+/*!
+  @brief Read interrupt flags and captured pin states of all ports in a
+  single transaction, which also clears the interrupt. Unlike
+  getLastInterruptPin(), every pin that triggered is reported.
+  @param readGPIO true to also read the current pin states in the same
+  transaction, so changes after the interrupt are not missed.
+  @returns flags and captured states, all zero on error.
+*/
+/**************************************************************************/
+MCP23XXX_Interrupt Adafruit_MCP23XXX::serviceInterrupt(bool readGPIO) {
+  MCP23XXX_Interrupt result;
 
-  // Port B ?
-  if (pinCount > 8) {
-    Adafruit_BusIO_Register INTCAPB(i2c_dev, spi_dev, MCP23XXX_SPIREG,
-                                    getRegister(MCP23XXX_INTCAP, 1));
-    INTCAPB.read(&intf);
-    intcap |= (uint16_t)intf << 8;
+  serviceInterrupt(&result, readGPIO);
+  return result;
+}
+
+/**************************************************************************/
+/*!
+  @brief Read interrupt flags and captured pin states, see
+  serviceInterrupt(bool), reporting whether the bus transfer succeeded.
+  @param irq set to flags and captured states, all zero on error.
+  @param readGPIO true to also read the current pin states in the same
+  transaction.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::serviceInterrupt(MCP23XXX_Interrupt *irq,
+                                         bool readGPIO) {
+  uint8_t ports = (pinCount > 8) ? 2 : 1;
+  uint8_t buffer[6];
+
+  irq->flags = irq->captured = irq->current = 0;
+
+  // INTF, INTCAP and GPIO are consecutive
+  if (!readRegisterBlock(MCP23XXX_INTF, buffer, readGPIO ? 3 : 2))
+    return false;
+
+  irq->flags = buffer[0];
+  irq->captured = buffer[ports];
+  if (readGPIO)
+    irq->current = buffer[2 * ports];
+  if (ports > 1) {
+    irq->flags |= (uint16_t)buffer[1] << 8;
+    irq->captured |= (uint16_t)buffer[3] << 8;
+    if (readGPIO)
+      irq->current |= (uint16_t)buffer[5] << 8;
   }
 
-  return intcap;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get pins with interrupt-on-change enabled, from GPINTEN.
+  @returns Mutli-bit value, bit set for each enabled pin.
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX::getInterruptEnabled() {
+  uint16_t pins = 0;
+
+  getInterruptEnabled(&pins);
+  return pins;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get pins with interrupt-on-change enabled, see
+  getInterruptEnabled(), reporting whether the bus transfer succeeded.
+  @param pins set to a bit for each enabled pin, unchanged on error.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::getInterruptEnabled(uint16_t *pins) {
+  uint8_t values[2] = {0, 0};
+
+  if (cacheEntry(MCP23XXX_GPINTEN, 0)) {
+    *pins = readRegisterPorts(MCP23XXX_GPINTEN);
+    return true;
+  }
+  if (!readRegisterBlock(MCP23XXX_GPINTEN, values, 1))
+    return false;
+  *pins = values[0] | ((uint16_t)values[1] << 8);
+  return true;
 }
 
 /**************************************************************************/
@@ -290,11 +581,955 @@ uint16_t Adafruit_MCP23XXX::getCapturedInterrupt() {
 uint16_t Adafruit_MCP23XXX::getRegister(uint8_t baseAddress, uint8_t port) {
   // MCP23x08
   uint16_t reg = baseAddress;
-  // MCP23x17 BANK=0
   if (pinCount > 8) {
-    reg <<= 1;
-    reg |= port;
+    if (regBank) {
+      // MCP23x17 BANK=1, Port B registers start at 0x10
+      reg |= port << 4;
+    } else {
+      // MCP23x17 BANK=0
+      reg <<= 1;
+      reg |= port;
+    }
   }
   // for SPI, add opcode as high byte
   return (spi_dev) ? (0x4000 | (hw_addr << 9) | reg) : reg;
 }
+
+/**************************************************************************/
+/*!
+  @brief Configure all pins at once. Output latches are written first, so
+  outputs start at the right level, then IODIR through GPPU in one
+  sequential transaction, then GPINTEN last so no interrupt fires while
+  DEFVAL and INTCON are being set. IOCON is left unchanged.
+  @param config pin configuration
+  @param verify true to read the registers back and compare
+  @return true if successful (and verified), otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::configure(const MCP23XXX_PortConfig &config,
+                                  bool verify) {
+  uint8_t ports = (pinCount > 8) ? 2 : 1;
+  uint8_t values[2 * (MCP23XXX_GPPU + 1)];
+  uint8_t iocon;
+
+  if (!readCachedRegister(MCP23XXX_IOCON, &iocon))
+    return false;
+
+  const uint16_t burst[MCP23XXX_GPPU + 1] = {
+      config.iodir, config.ipol, 0, config.defval, config.intcon,
+      (uint16_t)(iocon | (iocon << 8)), config.gppu};
+
+  if (!writeRegisterPorts(MCP23XXX_OLAT, config.olat))
+    return false;
+
+  // IODIR through GPPU are consecutive
+  for (uint8_t i = 0; i <= MCP23XXX_GPPU; i++) {
+    for (uint8_t port = 0; port < ports; port++)
+      values[i * ports + port] = burst[i] >> (8 * port);
+  }
+  if (!writeRegisterBlock(MCP23XXX_IODIR, values, MCP23XXX_GPPU + 1))
+    return false;
+
+  if (!writeRegisterPorts(MCP23XXX_GPINTEN, config.gpinten))
+    return false;
+
+  if (!verify)
+    return true;
+
+  // read back, bypassing the cache
+  uint8_t olat[2] = {0, 0};
+  bool cached = pauseCache();
+  bool ok = readRegisterBlock(MCP23XXX_IODIR, values, MCP23XXX_GPPU + 1) &&
+            readRegisterBlock(MCP23XXX_OLAT, olat, 1);
+  resumeCache(cached);
+  if (!ok)
+    return false;
+
+  uint16_t mask = (ports > 1) ? 0xFFFF : 0x00FF;
+  uint16_t expected[MCP23XXX_GPPU + 1] = {
+      config.iodir,  config.ipol, config.gpinten, config.defval,
+      config.intcon, 0,           config.gppu};
+  for (uint8_t i = 0; i <= MCP23XXX_GPPU; i++) {
+    uint16_t actual = values[i * ports];
+    if (ports > 1)
+      actual |= values[i * ports + 1] << 8;
+    if (i != MCP23XXX_IOCON && actual != (expected[i] & mask))
+      return false;
+  }
+
+  return (olat[0] | (olat[1] << 8)) == (config.olat & mask);
+}
+
+/**************************************************************************/
+/*!
+  @brief Read the complete register file in a single transaction, or one
+  per port on MCP23X17 with BANK=1.
+
+  NOTE: Reading INTCAP and GPIO clears pending interrupts.
+  @param regs snapshot to fill
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readAllRegisters(MCP23XXX_Registers *regs) {
+  uint8_t *dst = (uint8_t *)regs;
+
+  memset(regs, 0, sizeof(MCP23XXX_Registers));
+  if (pinCount > 8)
+    return readRegisterBlock(MCP23XXX_IODIR, dst, MCP23XXX_OLAT + 1);
+
+  // MCP23X08 registers are not interleaved, spread them over port A slots
+  uint8_t values[MCP23XXX_OLAT + 1];
+  if (!readRegisters(MCP23XXX_IODIR, values, sizeof(values)))
+    return false;
+  for (uint8_t i = 0; i < sizeof(values); i++)
+    dst[2 * i] = values[i];
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Write the complete register file in a single transaction. The
+  burst starts at OLAT and wraps around to IODIR, so pins switched to
+  outputs drive the restored latch values, never stale ones. On MCP23X17
+  with BANK=1 the latches are written first, then one burst per port. The
+  read-only INTF and INTCAP values are ignored, and GPIO is written with the
+  OLAT values. The IOCON BANK bit is kept at the current setting and SEQOP
+  is cleared, as required by this library.
+  @param regs snapshot to restore
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writeAllRegisters(const MCP23XXX_Registers *regs) {
+  MCP23XXX_Registers copy = *regs;
+  uint8_t *src = (uint8_t *)&copy;
+
+  // BANK and SEQOP
+  copy.iocon[0] = copy.iocon[1] =
+      (copy.iocon[0] & ~((1 << 7) | (1 << 5))) | (regBank << 7);
+  copy.gpio[0] = copy.olat[0];
+  copy.gpio[1] = copy.olat[1];
+
+  if (pinCount > 8 && regBank)
+    return writeRegisterBlock(MCP23XXX_OLAT, copy.olat, 1) &&
+           writeRegisterBlock(MCP23XXX_IODIR, src, MCP23XXX_OLAT + 1);
+
+  // OLAT, then IODIR through GPIO
+  uint8_t values[2 * (MCP23XXX_OLAT + 1)];
+  uint8_t ports = (pinCount > 8) ? 2 : 1;
+  uint8_t len = ports * (MCP23XXX_OLAT + 1);
+  for (uint8_t i = 0; i < ports; i++)
+    values[i] = copy.olat[i];
+  for (uint8_t i = 0; i < len - ports; i++)
+    values[ports + i] = (ports > 1) ? src[i] : src[2 * i];
+  return writeRegisters(MCP23XXX_OLAT, values, len);
+}
+
+/**************************************************************************/
+/*!
+  @brief Read all registers of one port, IODIR through OLAT. On MCP23X08,
+  and on MCP23X17 with BANK=1, this is a single transaction that does not
+  touch the other port. On MCP23X17 with BANK=0 the ports are interleaved,
+  so each register is read separately.
+
+  NOTE: Reading INTCAP and GPIO clears pending interrupts of the port.
+  @param regs buffer for MCP23XXX_OLAT + 1 values, indexed by register
+  @param port 0 for Port A, 1 for Port B (MCP23X17 only).
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readPortRegisters(uint8_t *regs, uint8_t port) {
+  if (pinCount <= 8 || regBank)
+    return readRegisters(MCP23XXX_IODIR, regs, MCP23XXX_OLAT + 1, port);
+
+  for (uint8_t reg = MCP23XXX_IODIR; reg <= MCP23XXX_OLAT; reg++) {
+    if (!readRegisters(reg, &regs[reg], 1, port))
+      return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Write all registers of one port, IODIR through OLAT, as one
+  transaction where the register layout allows it, see readPortRegisters().
+  IOCON is shared by both ports and is left unchanged, the read-only INTF
+  and INTCAP values are ignored, and GPIO is written with the OLAT value.
+  @param regs MCP23XXX_OLAT + 1 values, indexed by register
+  @param port 0 for Port A, 1 for Port B (MCP23X17 only).
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writePortRegisters(const uint8_t *regs, uint8_t port) {
+  uint8_t values[MCP23XXX_OLAT + 1];
+
+  memcpy(values, regs, sizeof(values));
+  values[MCP23XXX_GPIO] = values[MCP23XXX_OLAT];
+
+  if (pinCount <= 8 || regBank) {
+    if (!readCachedRegister(MCP23XXX_IOCON, &values[MCP23XXX_IOCON]))
+      return false;
+    return writeRegisters(MCP23XXX_IODIR, values, sizeof(values), port);
+  }
+
+  for (uint8_t reg = MCP23XXX_IODIR; reg <= MCP23XXX_OLAT; reg++) {
+    if (reg == MCP23XXX_IOCON || reg == MCP23XXX_INTF ||
+        reg == MCP23XXX_INTCAP || reg == MCP23XXX_GPIO)
+      continue;
+    if (!writeRegisters(reg, &values[reg], 1, port))
+      return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Change the bus clock. Supported for I2C and hardware SPI.
+
+  NOTE: On I2C this sets the clock of the whole TwoWire bus, for every
+  device on it, not just this chip.
+  @param freq clock frequency in Hz
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::setBusClock(uint32_t freq) {
+  if (i2c_dev) {
+    if (!i2c_dev->setSpeed(freq))
+      return false;
+#ifndef MCP23XXX_NO_SPI
+  } else if (spi_dev && spi_bus) {
+    // Adafruit_SPIDevice has a fixed clock, so replace it
+    releaseDevices();
+    spi_dev = new (busStorage) Adafruit_SPIDevice(
+        spi_cs, freq, SPI_BITORDER_MSBFIRST, SPI_MODE0, spi_bus);
+    if (!spi_dev->begin())
+      return false;
+#endif
+  } else {
+    return false;
+  }
+  busClock = freq;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get the bus clock set by begin_SPI() or setBusClock().
+  @returns clock frequency in Hz, 0 if not set by this library
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX::getBusClock() { return busClock; }
+
+/**************************************************************************/
+/*!
+  @brief Find the fastest reliable bus clock. Each candidate is tried in
+  order; test patterns are written to IPOL and read back, and the search
+  stops at the first failure. The setting margin steps below the fastest
+  passing one is kept. IPOL is restored afterwards. Interrupt-on-change is
+  disabled during the test, since inverting inputs would trigger it.
+
+  NOTE: Input pin states read during tuning may be inverted. On I2C the
+  clock of the whole TwoWire bus is changed, so only offer clocks that all
+  devices on the bus support. The clock in use must be known, so it can be
+  restored if no candidate passes: after begin_I2C() call setBusClock()
+  first. Otherwise nothing is tuned.
+  @param freqs candidate clock frequencies in Hz, slowest first
+  @param count number of candidates
+  @param margin number of steps to back off from the fastest passing one
+  @returns chosen clock frequency in Hz, 0 if none passed or the clock in
+  use is unknown
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX::autoTuneClock(const uint32_t *freqs,
+                                          uint8_t count, uint8_t margin) {
+  static const uint8_t patterns[] = {0x55, 0xAA, 0x00, 0xFF, 0x5A, 0xA5};
+  uint8_t ports = (pinCount > 8) ? 2 : 1;
+  uint8_t saved[2] = {0, 0};
+  uint8_t gpinten[2] = {0, 0};
+  uint8_t off[2] = {0, 0};
+  uint32_t original = busClock;
+  int16_t best = -1;
+
+  // read IPOL at the current, known good, clock
+  if (!original || !readRegisterBlock(MCP23XXX_IPOL, saved, 1) ||
+      !readRegisterBlock(MCP23XXX_GPINTEN, gpinten, 1) ||
+      !writeRegisterBlock(MCP23XXX_GPINTEN, off, 1))
+    return 0;
+
+  // test transfers must not touch the cache
+  bool cached = pauseCache();
+  for (uint8_t i = 0; i < count; i++) {
+    bool ok = setBusClock(freqs[i]);
+    for (uint8_t p = 0; ok && p < sizeof(patterns); p++) {
+      uint8_t out[2] = {patterns[p], (uint8_t)~patterns[p]};
+      uint8_t in[2] = {0, 0};
+      ok = writeRegisterBlock(MCP23XXX_IPOL, out, 1) &&
+           readRegisterBlock(MCP23XXX_IPOL, in, 1) && in[0] == out[0] &&
+           (ports < 2 || in[1] == out[1]);
+    }
+    if (!ok)
+      break;
+    best = i;
+  }
+  resumeCache(cached);
+
+  if (best < 0) {
+    setBusClock(original);
+    writeRegisterBlock(MCP23XXX_IPOL, saved, 1);
+    writeRegisterBlock(MCP23XXX_GPINTEN, gpinten, 1);
+    return 0;
+  }
+
+  best = (best > margin) ? best - margin : 0;
+  setBusClock(freqs[best]);
+  writeRegisterBlock(MCP23XXX_IPOL, saved, 1);
+  writeRegisterBlock(MCP23XXX_GPINTEN, gpinten, 1);
+
+  return freqs[best];
+}
+
+/**************************************************************************/
+/*!
+  @brief Enable or disable the register cache. When enabled, the
+  configuration registers (IODIR, IPOL, GPINTEN, DEFVAL, INTCON, IOCON, GPPU)
+  and the output latch (OLAT) are mirrored in RAM and written through, so
+  single pin operations only need one bus write. The cache is loaded from
+  the chip by begin_I2C()/begin_SPI(), or immediately if already initialized.
+
+  NOTE: The cache assumes this library is the only writer of these
+  registers. Call refreshCache() after a chip reset. Enabling always fails
+  when built with MCP23XXX_NO_CACHE.
+  @param enable true to enable caching, false to disable.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::enableCache(bool enable) {
+#ifdef MCP23XXX_NO_CACHE
+  return !enable;
+#else
+  cacheEnabled = enable;
+  if (enable && (i2c_dev || spi_dev))
+    return refreshCache();
+  return true;
+#endif
+}
+
+/**************************************************************************/
+/*!
+  @brief Reload the register cache from the chip.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::refreshCache() {
+  uint8_t values[2 * (MCP23XXX_GPPU + 1)];
+
+  // IODIR through GPPU are consecutive, OLAT follows GPIO
+  if (!readRegisterBlock(MCP23XXX_IODIR, values, MCP23XXX_GPPU + 1))
+    return false;
+  return readRegisterBlock(MCP23XXX_OLAT, values, 1);
+}
+
+/**************************************************************************/
+/*!
+  @brief Read consecutive registers from the chip in a single transaction.
+  @param baseAddress base register address of first register
+  @param buffer buffer to store register values in
+  @param len number of registers to read
+  @param port 0 for A, 1 for B (MCP23X17 only)
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readRegisters(uint8_t baseAddress, uint8_t *buffer,
+                                      uint8_t len, uint8_t port) {
+  uint16_t reg = getRegister(baseAddress, port);
+  Adafruit_BusIO_Register REG(i2c_dev, spi_dev, MCP23XXX_SPIREG, reg);
+
+#ifdef MCP23XXX_STATS
+  uint32_t start = micros();
+  bool ok = REG.read(buffer, len);
+  recordTransfer(baseAddress, reg & 0xFF, len, false, ok, start);
+  if (!ok)
+    return false;
+#else
+  if (!REG.read(buffer, len))
+    return false;
+#endif
+  if (cacheEnabled)
+    updateCache(reg & 0xFF, buffer, len, false);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Write consecutive registers on the chip in a single transaction.
+  @param baseAddress base register address of first register
+  @param buffer register values to write
+  @param len number of registers to write
+  @param port 0 for A, 1 for B (MCP23X17 only)
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writeRegisters(uint8_t baseAddress, uint8_t *buffer,
+                                       uint8_t len, uint8_t port) {
+  uint16_t reg = getRegister(baseAddress, port);
+  Adafruit_BusIO_Register REG(i2c_dev, spi_dev, MCP23XXX_SPIREG, reg);
+
+#ifdef MCP23XXX_STATS
+  uint32_t start = micros();
+  bool ok = REG.write(buffer, len);
+  recordTransfer(baseAddress, reg & 0xFF, len, true, ok, start);
+  if (!ok)
+    return false;
+#else
+  if (!REG.write(buffer, len))
+    return false;
+#endif
+  if (cacheEnabled)
+    updateCache(reg & 0xFF, buffer, len, true);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Read a single register, from the cache if possible.
+  @param baseAddress base register address
+  @param port 0 for A, 1 for B (MCP23X17 only)
+  @returns register value
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23XXX::readRegister(uint8_t baseAddress, uint8_t port) {
+  uint8_t value = 0;
+
+  readCachedRegister(baseAddress, &value, port);
+  return value;
+}
+
+/**************************************************************************/
+/*!
+  @brief Read a single register, from the cache if possible, reporting
+  whether the read succeeded.
+  @param baseAddress base register address
+  @param value set to the register value, unchanged on failure
+  @param port 0 for A, 1 for B (MCP23X17 only)
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readCachedRegister(uint8_t baseAddress, uint8_t *value,
+                                           uint8_t port) {
+  const uint8_t *cached = cacheEntry(baseAddress, port);
+
+  if (cached) {
+    *value = *cached;
+    return true;
+  }
+  return readRegisters(baseAddress, value, 1, port);
+}
+
+/**************************************************************************/
+/*!
+  @brief Write a single register. Skipped if the cache shows the register
+  already holds the value.
+  @param baseAddress base register address
+  @param value value to write
+  @param port 0 for A, 1 for B (MCP23X17 only)
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writeRegister(uint8_t baseAddress, uint8_t value,
+                                      uint8_t port) {
+  const uint8_t *cached = cacheEntry(baseAddress, port);
+
+  if (cached && *cached == value)
+    return true;
+  return writeRegisters(baseAddress, &value, 1, port);
+}
+
+/**************************************************************************/
+/*!
+  @brief Read-modify-write bits of a single register. The read comes from
+  the cache if possible.
+  @param baseAddress base register address
+  @param mask bits to modify
+  @param value new values for bits in mask
+  @param port 0 for A, 1 for B (MCP23X17 only)
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::updateRegister(uint8_t baseAddress, uint8_t mask,
+                                       uint8_t value, uint8_t port) {
+  uint8_t reg;
+
+  if (!readCachedRegister(baseAddress, &reg, port))
+    return false;
+  return writeRegister(baseAddress, (reg & ~mask) | (value & mask), port);
+}
+
+/**************************************************************************/
+/*!
+  @brief Read a register for all ports, from the cache if possible.
+  @param baseAddress base register address
+  @returns register values, port A in low byte and port B in high byte
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX::readRegisterPorts(uint8_t baseAddress) {
+  uint8_t values[2] = {0, 0};
+
+  if (cacheEntry(baseAddress, 0))
+    return *cacheEntry(baseAddress, 0) |
+           ((uint16_t)*cacheEntry(baseAddress, 1) << 8);
+  readRegisterBlock(baseAddress, values, 1);
+  return values[0] | ((uint16_t)values[1] << 8);
+}
+
+/**************************************************************************/
+/*!
+  @brief Write a register for one or both ports in a single transaction.
+  @param baseAddress base register address
+  @param value register values, port A in low byte and port B in high byte
+  @param ports bit 0 to write port A, bit 1 to write port B
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writeRegisterPorts(uint8_t baseAddress,
+                                           uint16_t value, uint8_t ports) {
+  uint8_t values[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+
+  if (pinCount <= 8)
+    ports &= 0x01;
+  if (ports == 0x03)
+    return writeRegisterBlock(baseAddress, values, 1);
+  if (ports == 0x02)
+    return writeRegister(baseAddress, values[1], 1);
+  if (ports == 0x01)
+    return writeRegister(baseAddress, values[0], 0);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Read-modify-write bits of a register for all ports. Ports without
+  bits in mask are not touched, and fully masked ports are not read.
+  @param baseAddress base register address
+  @param mask bits to modify, port A in low byte and port B in high byte
+  @param value new values for bits in mask
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::updateRegisterPorts(uint8_t baseAddress,
+                                            uint16_t mask, uint16_t value) {
+  uint8_t ports = ((mask & 0x00FF) ? 0x01 : 0) | ((mask & 0xFF00) ? 0x02 : 0);
+  bool cached = cacheEnabled && isCached(baseAddress);
+  uint16_t reg = 0;
+
+  if (pinCount <= 8) {
+    mask &= 0x00FF;
+    ports &= 0x01;
+  }
+  // only need current values if a port is partially modified
+  if (cached || ((ports & 0x01) && (mask & 0x00FF) != 0x00FF) ||
+      ((ports & 0x02) && (mask & 0xFF00) != 0xFF00))
+    reg = readRegisterPorts(baseAddress);
+  uint16_t old = reg;
+  reg = (reg & ~mask) | (value & mask);
+
+  // skip ports the cache shows are unchanged
+  if (cached) {
+    if ((old & 0x00FF) == (reg & 0x00FF))
+      ports &= ~0x01;
+    if ((old & 0xFF00) == (reg & 0xFF00))
+      ports &= ~0x02;
+  }
+  return writeRegisterPorts(baseAddress, reg, ports);
+}
+
+/**************************************************************************/
+/*!
+  @brief Read consecutive registers of all ports. Values are stored by
+  register, then by port. This is a single transaction, except on MCP23X17
+  with BANK=1 where the ports are not interleaved and each port is read
+  separately.
+  @param baseAddress base register address of first register
+  @param buffer buffer for count values per port
+  @param count number of registers per port, up to MCP23XXX_OLAT + 1
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readRegisterBlock(uint8_t baseAddress, uint8_t *buffer,
+                                          uint8_t count) {
+  uint8_t values[MCP23XXX_OLAT + 1];
+
+  if (!regBank)
+    return readRegisters(baseAddress, buffer, (pinCount > 8) ? 2 * count
+                                                             : count);
+
+  for (uint8_t port = 0; port < 2; port++) {
+    if (!readRegisters(baseAddress, values, count, port))
+      return false;
+    for (uint8_t i = 0; i < count; i++)
+      buffer[2 * i + port] = values[i];
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Write consecutive registers of all ports, see readRegisterBlock().
+  @param baseAddress base register address of first register
+  @param buffer count values per port, stored by register, then by port
+  @param count number of registers per port, up to MCP23XXX_OLAT + 1
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::writeRegisterBlock(uint8_t baseAddress,
+                                           uint8_t *buffer, uint8_t count) {
+  uint8_t values[MCP23XXX_OLAT + 1];
+
+  if (!regBank)
+    return writeRegisters(baseAddress, buffer, (pinCount > 8) ? 2 * count
+                                                              : count);
+
+  for (uint8_t port = 0; port < 2; port++) {
+    for (uint8_t i = 0; i < count; i++)
+      values[i] = buffer[2 * i + port];
+    if (!writeRegisters(baseAddress, values, count, port))
+      return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Enable or disable sequential addressing (IOCON.SEQOP). This
+  library expects it enabled, outside of streaming transfers.
+  @param enable true to increment the address pointer after each byte.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::setSequential(bool enable) {
+  return updateRegister(MCP23XXX_IOCON, (1 << 5), enable ? 0 : (1 << 5));
+}
+
+/**************************************************************************/
+/*!
+  @brief Number of register bytes that fit in one streaming transaction.
+  @returns chunk size
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23XXX::streamChunk() {
+  // I2C buffer also holds the register address
+  if (i2c_dev && i2c_dev->maxBufferSize() - 1 < MCP23XXX_STREAM_CHUNK)
+    return i2c_dev->maxBufferSize() - 1;
+  return MCP23XXX_STREAM_CHUNK;
+}
+
+/**************************************************************************/
+/*!
+  @brief Read GPIO samples in streaming transactions.
+  @param port 0 for Port A, 1 for Port B (MCP23X17 only).
+  @param both true to combine Port A and B into 16 bit samples (MCP23X17)
+  @param count number of samples to take
+  @param sink function receiving each sample
+  @param context passed to sink
+  @param rate if not nullptr, set to the effective sample rate in Hz
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::readStream(uint8_t port, bool both, size_t count,
+                                   MCP23XXX_StreamSink sink, void *context,
+                                   uint32_t *rate) {
+  uint8_t chunk[MCP23XXX_STREAM_CHUNK];
+  // with BANK=0 the address pointer toggles between A and B
+  bool pair = (pinCount > 8) && !regBank;
+  uint8_t max = pair ? (streamChunk() & ~1) : streamChunk();
+  size_t index = 0;
+  bool ok = true;
+
+  if (rate)
+    *rate = 0;
+  if (!count)
+    return true;
+  if (!setSequential(false))
+    return false;
+
+  // the cache assumes sequential addressing, GPIO only is read anyway
+  bool cached = pauseCache();
+  uint32_t start = micros();
+  while (ok && index < count) {
+    if (both && regBank) {
+      // BANK=1 ports are not adjacent, read both for each sample
+      ok = readRegisterBlock(MCP23XXX_GPIO, chunk, 1);
+      if (ok && !sink(context, index++, chunk[0] | (chunk[1] << 8)))
+        break;
+      continue;
+    }
+    size_t left = count - index;
+    uint8_t len = max;
+    if (len > (pair ? 2 * left : left))
+      len = pair ? 2 * left : left;
+    ok = readRegisters(MCP23XXX_GPIO, chunk, len, both ? 0 : port);
+    for (uint8_t i = 0; ok && i < len; i += pair ? 2 : 1) {
+      uint16_t sample = (pair && both) ? chunk[i] | (chunk[i + 1] << 8)
+                                       : chunk[i];
+      if (!sink(context, index++, sample)) {
+        count = index;
+        break;
+      }
+    }
+  }
+  uint32_t elapsed = micros() - start;
+  resumeCache(cached);
+
+  if (rate && elapsed)
+    *rate = (uint64_t)index * 1000000UL / elapsed;
+
+  return setSequential(true) && ok;
+}
+
+/**************************************************************************/
+/*!
+  @brief Destroy the bus interface from a previous begin_I2C()/begin_SPI(),
+  so its storage can be reused.
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::releaseDevices() {
+  // constructed in busStorage, so only the destructor is called
+  if (i2c_dev)
+    i2c_dev->~Adafruit_I2CDevice();
+  if (spi_dev)
+    spi_dev->~Adafruit_SPIDevice();
+  i2c_dev = nullptr;
+  spi_dev = nullptr;
+}
+
+/**************************************************************************/
+/*!
+  @brief Check if register is held in the cache.
+  @param baseAddress base register address
+  @returns true if cached
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::isCached(uint8_t baseAddress) {
+  return (baseAddress <= MCP23XXX_GPPU) || (baseAddress == MCP23XXX_OLAT);
+}
+
+/**************************************************************************/
+/*!
+  @brief Update cache after a sequential register transfer.
+  @param address chip register address of first register
+  @param values register values transferred
+  @param len number of registers transferred
+  @param isWrite true if values were written to the chip
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::updateCache(uint8_t address, const uint8_t *values,
+                                    uint8_t len, bool isWrite) {
+#ifndef MCP23XXX_NO_CACHE
+  // sequential access wraps around, except between the BANK=1 ports
+  uint8_t size = (pinCount > 8) ? 2 * (MCP23XXX_OLAT + 1) : MCP23XXX_OLAT + 1;
+
+  for (uint8_t i = 0; i < len; i++, address++) {
+    uint8_t base = address;
+    uint8_t port = 0;
+
+    if (!regBank && address >= size)
+      base = address = 0;
+
+    if (pinCount > 8) {
+      base = regBank ? (address & 0x0F) : (address >> 1);
+      port = regBank ? ((address >> 4) & 1) : (address & 1);
+    }
+
+    if (base > MCP23XXX_OLAT)
+      break;
+    // writing GPIO writes OLAT
+    if (isWrite && base == MCP23XXX_GPIO)
+      base = MCP23XXX_OLAT;
+    if (!isCached(base))
+      continue;
+    if (base == MCP23XXX_IOCON) {
+      // IOCON is shared by both ports
+      regCache[0][base] = regCache[1][base] = values[i];
+    } else {
+      regCache[port][base] = values[i];
+    }
+  }
+#else
+  (void)address;
+  (void)values;
+  (void)len;
+  (void)isWrite;
+#endif
+}
+
+/**************************************************************************/
+/*!
+  @brief Find the register layout of an MCP23X17, which keeps IOCON.BANK
+  when only the microcontroller is reset. With BANK=1, IOCON is at 0x05
+  with bit 7 set and mirrored at 0x15. With BANK=0 these are GPINTENB and
+  OLATB, so bit 7 of 0x05 is usually clear and only one read is needed.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::detectRegisterBank() {
+  uint8_t iocon[2] = {0, 0};
+  bool ok = true;
+
+  if (pinCount <= 8)
+    return true;
+
+  // read with the BANK=1 addresses, the cache is loaded afterwards
+  bool cached = pauseCache();
+  regBank = 1;
+  ok = readRegisters(MCP23XXX_IOCON, &iocon[0], 1, 0);
+  if (ok && (iocon[0] & (1 << 7)))
+    ok = readRegisters(MCP23XXX_IOCON, &iocon[1], 1, 1);
+  resumeCache(cached);
+  regBank = (ok && (iocon[0] & (1 << 7)) && iocon[0] == iocon[1]) ? 1 : 0;
+
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+  @brief Disable the register cache for raw transfers that bypass it.
+  @return the previous cache state, for resumeCache().
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX::pauseCache() {
+  bool cached = cacheEnabled;
+#ifndef MCP23XXX_NO_CACHE
+  cacheEnabled = false;
+#endif
+  return cached;
+}
+
+/**************************************************************************/
+/*!
+  @brief Restore the cache state saved by pauseCache().
+  @param enable value returned by pauseCache()
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::resumeCache(bool enable) {
+#ifndef MCP23XXX_NO_CACHE
+  cacheEnabled = enable;
+#else
+  (void)enable;
+#endif
+}
+
+/**************************************************************************/
+/*!
+  @brief Find the cached copy of a register.
+  @param baseAddress base register address
+  @param port 0 for port A, 1 for port B (MCP23X17 only)
+  @return pointer to the cached value, nullptr if the register is not cached.
+*/
+/**************************************************************************/
+uint8_t *Adafruit_MCP23XXX::cacheEntry(uint8_t baseAddress, uint8_t port) {
+#ifndef MCP23XXX_NO_CACHE
+  if (cacheEnabled && isCached(baseAddress))
+    return &regCache[port][baseAddress];
+#else
+  (void)baseAddress;
+  (void)port;
+#endif
+  return nullptr;
+}
+
+#ifdef MCP23XXX_STATS
+/**************************************************************************/
+/*!
+  @brief Get bus transfer statistics.
+  @param regClass MCP23XXX_STATS_GPIO, MCP23XXX_STATS_CONFIG,
+  MCP23XXX_STATS_INTERRUPT or MCP23XXX_STATS_BURST
+  @returns pointer to statistics, nullptr for an invalid class
+*/
+/**************************************************************************/
+const MCP23XXX_BusStats *Adafruit_MCP23XXX::getBusStats(uint8_t regClass) {
+  return (regClass < MCP23XXX_STATS_CLASSES) ? &stats[regClass] : nullptr;
+}
+
+/**************************************************************************/
+/*!
+  @brief Clear all bus transfer statistics.
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::resetBusStats() { memset(stats, 0, sizeof(stats)); }
+
+/**************************************************************************/
+/*!
+  @brief Set a function to be called after each bus transfer.
+  @param hook function to call, nullptr to remove
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::setBusHook(MCP23XXX_BusHook hook) { busHook = hook; }
+
+/**************************************************************************/
+/*!
+  @brief Find the register class of a transfer from every register it
+  touches, following the sequential address order of updateCache().
+  @param address chip address of first register
+  @param len number of registers transferred
+  @returns the class shared by all registers, or MCP23XXX_STATS_BURST
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23XXX::statsClass(uint8_t address, uint8_t len) {
+  uint8_t size = (pinCount > 8) ? 2 * (MCP23XXX_OLAT + 1) : MCP23XXX_OLAT + 1;
+  uint8_t first = MCP23XXX_STATS_CLASSES;
+
+  for (uint8_t i = 0; i < len; i++, address++) {
+    uint8_t base = address;
+    uint8_t regClass = MCP23XXX_STATS_CONFIG;
+
+    if (!regBank && address >= size)
+      base = address = 0;
+    if (pinCount > 8)
+      base = regBank ? (address & 0x0F) : (address >> 1);
+    if (base > MCP23XXX_OLAT)
+      break;
+
+    if (base == MCP23XXX_GPIO || base == MCP23XXX_OLAT)
+      regClass = MCP23XXX_STATS_GPIO;
+    else if (base == MCP23XXX_GPINTEN || base == MCP23XXX_DEFVAL ||
+             base == MCP23XXX_INTCON || base == MCP23XXX_INTF ||
+             base == MCP23XXX_INTCAP)
+      regClass = MCP23XXX_STATS_INTERRUPT;
+
+    if (first == MCP23XXX_STATS_CLASSES)
+      first = regClass;
+    else if (regClass != first)
+      return MCP23XXX_STATS_BURST;
+  }
+  return (first < MCP23XXX_STATS_CLASSES) ? first : MCP23XXX_STATS_CONFIG;
+}
+
+/**************************************************************************/
+/*!
+  @brief Account a finished bus transfer.
+  @param baseAddress base register address of first register
+  @param address chip address of first register
+  @param len number of registers transferred
+  @param isWrite true for a write, false for a read
+  @param ok true if the transfer succeeded
+  @param start micros() when the transfer started
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX::recordTransfer(uint8_t baseAddress, uint8_t address,
+                                       uint8_t len, bool isWrite, bool ok,
+                                       uint32_t start) {
+  uint32_t elapsed = micros() - start;
+  MCP23XXX_BusStats *s = &stats[statsClass(address, len)];
+  s->transactions++;
+  if (isWrite)
+    s->bytesWritten += len;
+  else
+    s->bytesRead += len;
+  if (!ok)
+    s->errors++;
+  s->totalMicros += elapsed;
+  if (elapsed > s->maxMicros)
+    s->maxMicros = elapsed;
+
+  if (busHook)
+    busHook(baseAddress, len, isWrite, ok, elapsed);
+}
+#endif
@@ -28,10 +28,124 @@
 #define MCP23XXX_SPIREG                                                        \
   ADDRESSED_OPCODE_BIT0_LOW_TO_WRITE //!< SPI register type
 
+#define MCP23XXX_SPI_FREQ 1000000 //!< Default SPI clock
+
 #define MCP_PORT(pin) ((pin < 8) ? 0 : 1) //!< Determine port from pin number
 
 #define MCP23XXX_INT_ERR 255 //!< Interrupt error
 
+#define MCP23XXX_STREAM_CHUNK 32 //!< Maximum bytes per streaming transaction
+
+// uncomment, or add to build flags, to count bus transfers
+// #define MCP23XXX_STATS
+
+// uncomment, or add to build flags, to leave the register cache and batched
+// output out of every chip object
+// #define MCP23XXX_NO_CACHE
+
+// uncomment, or add to build flags, for I2C only builds: begin_SPI() is left
+// out and the bus device storage is sized for Adafruit_I2CDevice
+// #define MCP23XXX_NO_SPI
+
+#define MCP23XXX_STATS_GPIO 0      //!< GPIO and OLAT transfers
+#define MCP23XXX_STATS_CONFIG 1    //!< Configuration register transfers
+#define MCP23XXX_STATS_INTERRUPT 2 //!< Interrupt register transfers
+#define MCP23XXX_STATS_BURST 3     //!< Transfers spanning several classes
+#define MCP23XXX_STATS_CLASSES 4   //!< Number of register classes
+
+/**************************************************************************/
+/*!
+    @brief  Snapshot of the complete register file. Index 0 is Port A and
+    index 1 is Port B (MCP23X17 only). Layout matches the MCP23X17 with
+    IOCON.BANK = 0, whatever the current setting.
+*/
+/**************************************************************************/
+typedef struct {
+  uint8_t iodir[2];   ///< I/O direction
+  uint8_t ipol[2];    ///< Input polarity
+  uint8_t gpinten[2]; ///< Interrupt-on-change enable
+  uint8_t defval[2];  ///< Default compare value
+  uint8_t intcon[2];  ///< Interrupt control
+  uint8_t iocon[2];   ///< Configuration, same value for both ports
+  uint8_t gppu[2];    ///< Pull-up resistors
+  uint8_t intf[2];    ///< Interrupt flags
+  uint8_t intcap[2];  ///< Interrupt captured values
+  uint8_t gpio[2];    ///< Port values
+  uint8_t olat[2];    ///< Output latches
+} MCP23XXX_Registers;
+
+/**************************************************************************/
+/*!
+    @brief  Interrupt state read by serviceInterrupt(). Bit 0 is pin 0.
+*/
+/**************************************************************************/
+typedef struct {
+  uint16_t flags;    ///< Pins that caused the interrupt (INTF)
+  uint16_t captured; ///< Pin states at time of interrupt (INTCAP)
+  uint16_t current;  ///< Pin states after servicing (GPIO), if requested
+} MCP23XXX_Interrupt;
+
+/**************************************************************************/
+/*!
+    @brief  Bus transfer statistics for one register class. Only collected
+    when MCP23XXX_STATS is defined.
+*/
+/**************************************************************************/
+typedef struct {
+  uint32_t transactions; ///< Number of transfers
+  uint32_t bytesRead;    ///< Register bytes read
+  uint32_t bytesWritten; ///< Register bytes written
+  uint32_t errors;       ///< Failed transfers
+  uint32_t totalMicros;  ///< Cumulative transfer time
+  uint32_t maxMicros;    ///< Longest transfer time
+} MCP23XXX_BusStats;
+
+/*!
+    @brief  Called after each bus transfer when MCP23XXX_STATS is defined.
+    @param baseAddress base register address of first register
+    @param len number of registers transferred
+    @param isWrite true for a write, false for a read
+    @param ok true if the transfer succeeded
+    @param elapsed transfer time in microseconds
+*/
+typedef void (*MCP23XXX_BusHook)(uint8_t baseAddress, uint8_t len,
+                                 bool isWrite, bool ok, uint32_t elapsed);
+
+/**************************************************************************/
+/*!
+    @brief  Configuration of all pins, for configure(). Bit 0 is pin 0.
+*/
+/**************************************************************************/
+typedef struct {
+  uint16_t iodir;   ///< I/O direction, 1 for input
+  uint16_t ipol;    ///< Input polarity, 1 to invert
+  uint16_t gpinten; ///< Interrupt-on-change enable
+  uint16_t defval;  ///< Default compare value
+  uint16_t intcon;  ///< Interrupt control, 1 to compare against DEFVAL
+  uint16_t gppu;    ///< Pull-up resistors
+  uint16_t olat;    ///< Output latches
+} MCP23XXX_PortConfig;
+
+/**************************************************************************/
+/*!
+    @brief  Run of equal samples from readGPIOChanges().
+*/
+/**************************************************************************/
+typedef struct {
+  uint16_t value;  ///< Pin states, bit 0 is pin 0
+  uint16_t length; ///< Number of consecutive samples with this value
+} MCP23XXX_Run;
+
+/*!
+    @brief  Receives samples from a streaming read.
+    @param context caller data
+    @param index sample number
+    @param sample pin states, bit 0 is pin 0
+    @return true to continue, false to stop the capture.
+*/
+typedef bool (*MCP23XXX_StreamSink)(void *context, size_t index,
+                                    uint16_t sample);
+
 /**************************************************************************/
 /*!
     @brief  Base class for all MCP23XXX variants.
@@ -39,12 +153,20 @@
 /**************************************************************************/
 class Adafruit_MCP23XXX {
 public:
+  Adafruit_MCP23XXX() {}
+  // the bus interface is held inside the object, so it cannot be copied
+  Adafruit_MCP23XXX(const Adafruit_MCP23XXX &) = delete;
+  Adafruit_MCP23XXX &operator=(const Adafruit_MCP23XXX &) = delete;
+  ~Adafruit_MCP23XXX();
+
   // init
   bool begin_I2C(uint8_t i2c_addr = MCP23XXX_ADDR, TwoWire *wire = &Wire);
+#ifndef MCP23XXX_NO_SPI
   bool begin_SPI(uint8_t cs_pin, SPIClass *theSPI = &SPI,
-                 uint8_t _hw_addr = 0x00);
+                 uint8_t _hw_addr = 0x00, uint32_t freq = MCP23XXX_SPI_FREQ);
   bool begin_SPI(int8_t cs_pin, int8_t sck_pin, int8_t miso_pin,
                  int8_t mosi_pin, uint8_t _hw_addr = 0x00);
+#endif
 
   // main Arduino API methods
   void pinMode(uint8_t pin, uint8_t mode);
@@ -54,6 +176,19 @@ public:
   // bulk access
   uint8_t readGPIO(uint8_t port = 0);
   void writeGPIO(uint8_t value, uint8_t port = 0);
+  void pinModeMask(uint16_t mask, uint8_t mode);
+  void digitalWriteMask(uint16_t mask, uint16_t values);
+
+  // streaming
+  bool writeGPIOStream(const uint8_t *values, size_t count, uint8_t port = 0);
+  bool readGPIOStream(uint8_t *samples, size_t count, uint8_t port = 0,
+                      uint32_t *rate = nullptr);
+  size_t readGPIOChanges(MCP23XXX_Run *runs, size_t maxRuns, size_t count,
+                         uint32_t *rate = nullptr);
+
+  // batched output
+  bool beginBatch();
+  bool commit();
 
   // interrupts
   void setupInterrupts(bool mirroring, bool openDrain, uint8_t polarity);
@@ -62,16 +197,116 @@ public:
   void clearInterrupts();
   uint8_t getLastInterruptPin();
   uint16_t getCapturedInterrupt();
+  MCP23XXX_Interrupt serviceInterrupt(bool readGPIO = false);
+  bool serviceInterrupt(MCP23XXX_Interrupt *irq, bool readGPIO = false);
+  uint16_t getInterruptEnabled();
+  bool getInterruptEnabled(uint16_t *pins);
+
+  // full configuration
+  bool configure(const MCP23XXX_PortConfig &config, bool verify = false);
+
+  // full register file
+  bool readAllRegisters(MCP23XXX_Registers *regs);
+  bool writeAllRegisters(const MCP23XXX_Registers *regs);
+  bool readPortRegisters(uint8_t *regs, uint8_t port = 0);
+  bool writePortRegisters(const uint8_t *regs, uint8_t port = 0);
+
+  // bus clock
+  bool setBusClock(uint32_t freq);
+  uint32_t getBusClock();
+  uint32_t autoTuneClock(const uint32_t *freqs, uint8_t count,
+                         uint8_t margin = 1);
+
+  // register cache
+  bool enableCache(bool enable = true);
+  bool refreshCache();
+
+#ifdef MCP23XXX_STATS
+  // bus statistics
+  const MCP23XXX_BusStats *getBusStats(uint8_t regClass);
+  void resetBusStats();
+  void setBusHook(MCP23XXX_BusHook hook);
+#endif
 
 protected:
   Adafruit_I2CDevice *i2c_dev = nullptr; ///< Pointer to I2C bus interface
   Adafruit_SPIDevice *spi_dev = nullptr; ///< Pointer to SPI bus interface
   uint8_t pinCount;                      ///< Total number of GPIO pins
-  uint8_t hw_addr;                       ///< HW address matching A2/A1/A0 pins
+  uint8_t hw_addr = 0;                   ///< HW address matching A2/A1/A0 pins
+  uint8_t regBank = 0; ///< IOCON.BANK setting, MCP23X17 only
   uint16_t getRegister(uint8_t baseAddress, uint8_t port = 0);
 
+  // register access
+  bool readRegisters(uint8_t baseAddress, uint8_t *buffer, uint8_t len,
+                     uint8_t port = 0);
+  bool writeRegisters(uint8_t baseAddress, uint8_t *buffer, uint8_t len,
+                      uint8_t port = 0);
+  uint8_t readRegister(uint8_t baseAddress, uint8_t port = 0);
+  bool readCachedRegister(uint8_t baseAddress, uint8_t *value,
+                          uint8_t port = 0);
+  bool writeRegister(uint8_t baseAddress, uint8_t value, uint8_t port = 0);
+  bool updateRegister(uint8_t baseAddress, uint8_t mask, uint8_t value,
+                      uint8_t port = 0);
+  bool readRegisterBlock(uint8_t baseAddress, uint8_t *buffer, uint8_t count);
+  bool writeRegisterBlock(uint8_t baseAddress, uint8_t *buffer, uint8_t count);
+  uint16_t readRegisterPorts(uint8_t baseAddress);
+  bool writeRegisterPorts(uint8_t baseAddress, uint16_t value,
+                          uint8_t ports = 0x03);
+  bool updateRegisterPorts(uint8_t baseAddress, uint16_t mask,
+                           uint16_t value);
+  bool setSequential(bool enable);
+  uint8_t streamChunk();
+  bool readStream(uint8_t port, bool both, size_t count,
+                  MCP23XXX_StreamSink sink, void *context, uint32_t *rate);
+
+  bool detectRegisterBank();
+  bool pauseCache();
+  void resumeCache(bool enable);
+  uint8_t *cacheEntry(uint8_t baseAddress, uint8_t port);
+
+#ifdef MCP23XXX_NO_CACHE
+  static const bool cacheEnabled = false; ///< No register cache compiled in
+#else
+  bool cacheEnabled = false; ///< True if register cache is in use
+  uint8_t regCache[2][MCP23XXX_OLAT + 1] = {}; ///< Cached registers per port
+
+  bool batchActive = false; ///< True between beginBatch() and commit()
+  uint16_t batchImage = 0;  ///< Pending output latch values for batch
+  uint8_t batchPorts = 0;   ///< Ports modified during batch
+#endif
+
 private:
-  uint8_t buffer[4];
+  template <uint8_t N> friend class Adafruit_MCP23X17_Bank;
+  friend class Adafruit_MCP23X17_Async;
+  friend class Adafruit_MCP23X17_Keypad;
+  friend class Adafruit_MCP23XXX_Poller;
+  friend class Adafruit_MCP23XXX_Shared;
+
+  // storage for i2c_dev or spi_dev, avoids heap allocation
+#ifdef MCP23XXX_NO_SPI
+  alignas(Adafruit_I2CDevice) uint8_t busStorage[sizeof(Adafruit_I2CDevice)];
+#else
+  alignas(Adafruit_I2CDevice) alignas(Adafruit_SPIDevice) uint8_t
+      busStorage[(sizeof(Adafruit_I2CDevice) > sizeof(Adafruit_SPIDevice))
+                     ? sizeof(Adafruit_I2CDevice)
+                     : sizeof(Adafruit_SPIDevice)];
+#endif
+  uint32_t busClock = 0;
+#ifndef MCP23XXX_NO_SPI
+  int8_t spi_cs = -1;
+  SPIClass *spi_bus = nullptr;
+#endif
+  void releaseDevices();
+#ifdef MCP23XXX_STATS
+  MCP23XXX_BusStats stats[MCP23XXX_STATS_CLASSES] = {};
+  MCP23XXX_BusHook busHook = nullptr;
+  uint8_t statsClass(uint8_t address, uint8_t len);
+  void recordTransfer(uint8_t baseAddress, uint8_t address, uint8_t len,
+                      bool isWrite, bool ok, uint32_t start);
+#endif
+  bool isCached(uint8_t baseAddress);
+  void updateCache(uint8_t address, const uint8_t *values, uint8_t len,
+                   bool isWrite);
 };
 
 #endif
\ No newline at end of file
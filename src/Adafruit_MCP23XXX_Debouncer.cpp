@@ -0,0 +1,108 @@
+/*!
+ * @file Adafruit_MCP23XXX_Debouncer.cpp
+ */
+
+#include "Adafruit_MCP23XXX_Debouncer.h"
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param depth number of equal samples needed to accept a change, 1 to
+  MCP23XXX_DEBOUNCE_MAX
+  @param initial initial debounced state
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX_Debouncer::Adafruit_MCP23XXX_Debouncer(uint8_t depth,
+                                                         uint16_t initial) {
+  setDepth(depth);
+  reset(initial);
+}
+
+/**************************************************************************/
+/*!
+  @brief Set the debounce depth. Pending counts are kept.
+  @param depth number of equal samples needed to accept a change, 1 to
+  MCP23XXX_DEBOUNCE_MAX
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Debouncer::setDepth(uint8_t depth) {
+  if (depth < 1)
+    depth = 1;
+  if (depth > MCP23XXX_DEBOUNCE_MAX)
+    depth = MCP23XXX_DEBOUNCE_MAX;
+  this->depth = depth;
+}
+
+/**************************************************************************/
+/*!
+  @brief Set the debounced state and clear all pending counts.
+  @param initial new debounced state
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Debouncer::reset(uint16_t initial) {
+  counter[0] = counter[1] = counter[2] = counter[3] = 0;
+  state = initial;
+  lastChange = 0;
+}
+
+/**************************************************************************/
+/*!
+  @brief Add a sample of all pins. Takes the same time no matter how many
+  pins change.
+  @param sample pin states, bit 0 is pin 0
+  @returns pins whose debounced state changed with this sample
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX_Debouncer::update(uint16_t sample) {
+  uint16_t delta = sample ^ state;
+  uint16_t carry = delta;
+  uint16_t match = 0xFFFF;
+
+  for (uint8_t k = 0; k < 4; k++) {
+    // count pins that differ, restart pins that agree with state
+    uint16_t next = carry & counter[k];
+    counter[k] = (counter[k] ^ carry) & delta;
+    carry = next;
+    // pins whose count reached depth
+    match &= ((depth >> k) & 1) ? counter[k] : ~counter[k];
+  }
+
+  lastChange = match & delta;
+  state ^= lastChange;
+  for (uint8_t k = 0; k < 4; k++)
+    counter[k] &= ~lastChange;
+
+  return lastChange;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get debounced pin states.
+  @returns pin states, bit 0 is pin 0
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX_Debouncer::read() { return state; }
+
+/**************************************************************************/
+/*!
+  @brief Pins that changed on the last update().
+  @returns changed pins, bit 0 is pin 0
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX_Debouncer::changed() { return lastChange; }
+
+/**************************************************************************/
+/*!
+  @brief Pins that went from LOW to HIGH on the last update().
+  @returns rising pins, bit 0 is pin 0
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX_Debouncer::rose() { return lastChange & state; }
+
+/**************************************************************************/
+/*!
+  @brief Pins that went from HIGH to LOW on the last update().
+  @returns falling pins, bit 0 is pin 0
+*/
+/**************************************************************************/
+uint16_t Adafruit_MCP23XXX_Debouncer::fell() { return lastChange & ~state; }
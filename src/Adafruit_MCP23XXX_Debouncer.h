@@ -0,0 +1,39 @@
+/*!
+ * @file Adafruit_MCP23XXX_Debouncer.h
+ */
+
+#ifndef __ADAFRUIT_MCP23XXX_DEBOUNCER_H__
+#define __ADAFRUIT_MCP23XXX_DEBOUNCER_H__
+
+#include <Arduino.h>
+
+#define MCP23XXX_DEBOUNCE_MAX 15 //!< Maximum debounce depth
+
+/**************************************************************************/
+/*!
+    @brief  Debounces 16 inputs at once using vertical counters. Feed it
+    samples from readGPIOAB(), readGPIO() or getCapturedInterrupt(). A pin
+    changes state after it reads the new level for depth samples in a row.
+*/
+/**************************************************************************/
+class Adafruit_MCP23XXX_Debouncer {
+public:
+  Adafruit_MCP23XXX_Debouncer(uint8_t depth = 4, uint16_t initial = 0);
+
+  void setDepth(uint8_t depth);
+  void reset(uint16_t initial = 0);
+  uint16_t update(uint16_t sample);
+
+  uint16_t read();
+  uint16_t changed();
+  uint16_t rose();
+  uint16_t fell();
+
+private:
+  uint16_t counter[4]; // bit planes of per pin counters
+  uint16_t state;
+  uint16_t lastChange;
+  uint8_t depth;
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*!
+ * @file Adafruit_MCP23XXX_Dispatcher.cpp
+ */
+
+#include "Adafruit_MCP23XXX_Dispatcher.h"
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param chips array of pointers to initialized chips sharing the INT line
+  @param count number of chips, at most MCP23XXX_DISPATCH_MAX
+  @param int_pin microcontroller pin attached to the INT line, or -1 to
+  service every enabled chip
+  @param active level of the INT line while asserted, HIGH or LOW
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX_Dispatcher::Adafruit_MCP23XXX_Dispatcher(
+    Adafruit_MCP23XXX **chips, uint8_t count, int8_t int_pin,
+    uint8_t active) {
+  this->chips = chips;
+  this->count =
+      (count > MCP23XXX_DISPATCH_MAX) ? MCP23XXX_DISPATCH_MAX : count;
+  this->int_pin = int_pin;
+  this->active = active;
+}
+
+/**************************************************************************/
+/*!
+  @brief Reload which chips have interrupts enabled, from their GPINTEN
+  registers. Call after changing interrupt setup on any chip. dispatch()
+  calls it until it has succeeded once. A chip that cannot be read keeps
+  its previous state.
+  @return true if every chip was read, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Dispatcher::refresh() {
+  bool ok = true;
+
+  for (uint8_t i = 0; i < count; i++) {
+    uint16_t pins;
+
+    if (!chips[i]->getInterruptEnabled(&pins)) {
+      ok = false;
+      continue;
+    }
+    if (pins)
+      enabled |= 1 << i;
+    else
+      enabled &= ~(1 << i);
+  }
+  refreshed = ok;
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+  @brief Service pending interrupts. Only chips with interrupts enabled are
+  read, each with a single transaction, and servicing stops as soon as the
+  INT line is released. If a chip asserts again while the others are
+  serviced, the chips are passed over again, up to
+  MCP23XXX_DISPATCH_PASSES times, so the line is not left active.
+  @param callback function called for each chip that had an interrupt
+  @returns number of interrupts serviced
+*/
+/**************************************************************************/
+uint8_t
+Adafruit_MCP23XXX_Dispatcher::dispatch(MCP23XXX_DispatchCallback callback) {
+  uint8_t serviced = 0;
+
+  // the chips are usually started after the dispatcher is constructed
+  if (!refreshed)
+    refresh();
+  for (uint8_t pass = 0; pass < MCP23XXX_DISPATCH_PASSES; pass++) {
+    for (uint8_t i = 0; i < count; i++) {
+      if (!(enabled & (1 << i)))
+        continue;
+      if (int_pin >= 0 && digitalRead(int_pin) != active)
+        return serviced;
+
+      MCP23XXX_Interrupt irq = chips[i]->serviceInterrupt();
+      if (irq.flags) {
+        if (callback)
+          callback(i, irq.flags, irq.captured);
+        serviced++;
+      }
+    }
+    // without the INT line there is no way to tell if another pass is needed
+    if (int_pin < 0)
+      break;
+  }
+
+  return serviced;
+}
@@ -0,0 +1,45 @@
+/*!
+ * @file Adafruit_MCP23XXX_Dispatcher.h
+ */
+
+#ifndef __ADAFRUIT_MCP23XXX_DISPATCHER_H__
+#define __ADAFRUIT_MCP23XXX_DISPATCHER_H__
+
+#include "Adafruit_MCP23XXX.h"
+
+#define MCP23XXX_DISPATCH_MAX 8    //!< Maximum chips on one shared INT line
+#define MCP23XXX_DISPATCH_PASSES 4 //!< Maximum passes over the chips
+
+/*!
+    @brief  Interrupt dispatch callback.
+    @param chip index of chip in the dispatcher
+    @param flags pins that caused the interrupt
+    @param captured pin states at time of interrupt
+*/
+typedef void (*MCP23XXX_DispatchCallback)(uint8_t chip, uint16_t flags,
+                                          uint16_t captured);
+
+/**************************************************************************/
+/*!
+    @brief  Services several chips whose INT outputs are wired together,
+    configured with setupInterrupts(mirroring, true, LOW).
+*/
+/**************************************************************************/
+class Adafruit_MCP23XXX_Dispatcher {
+public:
+  Adafruit_MCP23XXX_Dispatcher(Adafruit_MCP23XXX **chips, uint8_t count,
+                               int8_t int_pin = -1, uint8_t active = LOW);
+
+  bool refresh();
+  uint8_t dispatch(MCP23XXX_DispatchCallback callback);
+
+private:
+  Adafruit_MCP23XXX **chips;
+  uint8_t count;
+  int8_t int_pin;
+  uint8_t active;
+  uint8_t enabled = 0;
+  bool refreshed = false;
+};
+
+#endif
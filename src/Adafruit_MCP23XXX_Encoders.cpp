@@ -0,0 +1,141 @@
+/*!
+ * @file Adafruit_MCP23XXX_Encoders.cpp
+ */
+
+#include "Adafruit_MCP23XXX_Encoders.h"
+
+#define ENC_ILLEGAL 2 //!< Both inputs changed, direction unknown
+
+/*!
+    @brief  Step for each (previous << 2 | next) state, where a state is
+    (A << 1 | B).
+*/
+// clang-format off
+static const int8_t encoderTable[16] = {
+  0,           -1,          1,           ENC_ILLEGAL, // from 00
+  1,           0,           ENC_ILLEGAL, -1,          // from 01
+  -1,          ENC_ILLEGAL, 0,           1,           // from 10
+  ENC_ILLEGAL, 1,           -1,          0            // from 11
+};
+// clang-format on
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param mcp Pointer to initialized MCP23XXX
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX_Encoders::Adafruit_MCP23XXX_Encoders(Adafruit_MCP23XXX *mcp) {
+  this->mcp = mcp;
+}
+
+/**************************************************************************/
+/*!
+  @brief Add an encoder. Both pins are set to INPUT_PULLUP with an
+  interrupt on CHANGE.
+  @param pinA pin of encoder output A
+  @param pinB pin of encoder output B
+  @returns encoder index, or -1 if too many encoders
+*/
+/**************************************************************************/
+int8_t Adafruit_MCP23XXX_Encoders::add(uint8_t pinA, uint8_t pinB) {
+  if (count >= MCP23XXX_MAX_ENCODERS)
+    return -1;
+
+  mcp->pinMode(pinA, INPUT_PULLUP);
+  mcp->pinMode(pinB, INPUT_PULLUP);
+  mcp->setupInterruptPin(pinA, CHANGE);
+  mcp->setupInterruptPin(pinB, CHANGE);
+
+  this->pinA[count] = pinA;
+  this->pinB[count] = pinB;
+  state[count] = (mcp->digitalRead(pinA) << 1) | mcp->digitalRead(pinB);
+  position[count] = 0;
+  lost[count] = 0;
+
+  return count++;
+}
+
+/**************************************************************************/
+/*!
+  @brief Service the interrupt and decode all encoders. Reads INTF, INTCAP
+  and GPIO in one transaction; the levels at interrupt time and the
+  current levels are both decoded, so two edges per pin are caught. Ports
+  that did not interrupt use the current levels only.
+  @returns true if any position changed
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Encoders::update() {
+  MCP23XXX_Interrupt irq = mcp->serviceInterrupt(true);
+  if (!irq.flags)
+    return false;
+
+  // INTCAP only holds new levels for ports that interrupted
+  uint16_t mask = ((irq.flags & 0x00FF) ? 0x00FF : 0) |
+                  ((irq.flags & 0xFF00) ? 0xFF00 : 0);
+  bool changed = decode((irq.captured & mask) | (irq.current & ~mask));
+  return decode(irq.current) || changed;
+}
+
+/**************************************************************************/
+/*!
+  @brief Advance all encoders to new pin levels, for example from
+  getCapturedInterrupt().
+  @param levels pin states, bit 0 is pin 0
+  @returns true if any position changed
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Encoders::decode(uint16_t levels) {
+  bool changed = false;
+
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t a = (levels >> pinA[i]) & 1;
+    uint8_t b = (levels >> pinB[i]) & 1;
+    int8_t step = encoderTable[(state[i] << 2) | (a << 1) | b];
+
+    if (step == ENC_ILLEGAL) {
+      lost[i]++;
+    } else if (step) {
+      position[i] += step;
+      changed = true;
+    }
+    state[i] = (a << 1) | b;
+  }
+
+  return changed;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get encoder position, in edges (four per quadrature cycle).
+  @param index encoder index from add()
+  @returns signed position
+*/
+/**************************************************************************/
+int32_t Adafruit_MCP23XXX_Encoders::getPosition(uint8_t index) {
+  return (index < count) ? position[index] : 0;
+}
+
+/**************************************************************************/
+/*!
+  @brief Set encoder position.
+  @param index encoder index from add()
+  @param position new position
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Encoders::setPosition(uint8_t index, int32_t position) {
+  if (index < count)
+    this->position[index] = position;
+}
+
+/**************************************************************************/
+/*!
+  @brief Number of illegal transitions seen, where both pins changed
+  between snapshots and steps were lost.
+  @param index encoder index from add()
+  @returns lost step count
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX_Encoders::getLostSteps(uint8_t index) {
+  return (index < count) ? lost[index] : 0;
+}
@@ -0,0 +1,40 @@
+/*!
+ * @file Adafruit_MCP23XXX_Encoders.h
+ */
+
+#ifndef __ADAFRUIT_MCP23XXX_ENCODERS_H__
+#define __ADAFRUIT_MCP23XXX_ENCODERS_H__
+
+#include "Adafruit_MCP23XXX.h"
+
+#define MCP23XXX_MAX_ENCODERS 8 //!< Maximum encoders per chip
+
+/**************************************************************************/
+/*!
+    @brief  Quadrature encoder decoder. All encoders on a chip are decoded
+    from a single interrupt snapshot with a lookup table state machine.
+*/
+/**************************************************************************/
+class Adafruit_MCP23XXX_Encoders {
+public:
+  Adafruit_MCP23XXX_Encoders(Adafruit_MCP23XXX *mcp);
+
+  int8_t add(uint8_t pinA, uint8_t pinB);
+  bool update();
+  bool decode(uint16_t levels);
+
+  int32_t getPosition(uint8_t index);
+  void setPosition(uint8_t index, int32_t position);
+  uint32_t getLostSteps(uint8_t index);
+
+private:
+  Adafruit_MCP23XXX *mcp;
+  uint8_t count = 0;
+  uint8_t pinA[MCP23XXX_MAX_ENCODERS];
+  uint8_t pinB[MCP23XXX_MAX_ENCODERS];
+  uint8_t state[MCP23XXX_MAX_ENCODERS];
+  int32_t position[MCP23XXX_MAX_ENCODERS];
+  uint32_t lost[MCP23XXX_MAX_ENCODERS];
+};
+
+#endif
@@ -0,0 +1,146 @@
+/*!
+ * @file Adafruit_MCP23XXX_Events.cpp
+ */
+
+#include "Adafruit_MCP23XXX_Events.h"
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param mcp Pointer to initialized MCP23XXX, with interrupts set up using
+  setupInterruptPin().
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX_Events::Adafruit_MCP23XXX_Events(Adafruit_MCP23XXX *mcp) {
+  this->mcp = mcp;
+  for (uint8_t pin = 0; pin < 16; pin++)
+    callbacks[pin] = nullptr;
+}
+
+/**************************************************************************/
+/*!
+  @brief Register a callback for changes on a pin.
+  @param pin the Arduino pin number
+  @param callback function called by drain(), nullptr to remove
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Events::onPin(uint8_t pin,
+                                     MCP23XXX_EventCallback callback) {
+  if (pin < 16)
+    callbacks[pin] = callback;
+}
+
+/**************************************************************************/
+/*!
+  @brief Record that the INT line fired. Call this from the host
+  microcontroller ISR attached to INTA/B. Only the timestamp is taken here,
+  no bus access is done.
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Events::handleInterrupt() {
+  // keep time of first edge until capture() picks it up
+  if (!pending) {
+    pendingTime = micros();
+    pending = true;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief Read a pending interrupt from the chip and queue it. This is the
+  only producer. Call it from loop(), or from an ISR or task on platforms
+  that allow bus access there. If the bus read fails, the interrupt stays
+  pending and is read again by the next call.
+  @return true if an event was queued, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Events::capture() {
+  if (!pending)
+    return false;
+
+  // pendingTime is not written again until pending is cleared
+  uint32_t timestamp = pendingTime;
+  pending = false;
+
+  MCP23XXX_Interrupt irq;
+  if (!mcp->serviceInterrupt(&irq)) {
+    // INT is still asserted and no new edge will come, retry next time
+    pendingTime = timestamp;
+    pending = true;
+    return false;
+  }
+  if (!irq.flags)
+    return false;
+
+  // the slot is filled before head publishes it to the consumer
+  uint8_t slot = head;
+  uint8_t next = (slot + 1) & (MCP23XXX_EVENT_QUEUE_SIZE - 1);
+  if (next == tail) {
+    overflowCount++;
+    return false;
+  }
+  queue[slot].timestamp = timestamp;
+  queue[slot].flags = irq.flags;
+  queue[slot].captured = irq.captured;
+  head = next;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Remove the oldest event from the queue.
+  @param event event to fill
+  @return true if an event was available, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Events::pop(MCP23XXX_Event *event) {
+  // the slot is copied before tail hands it back to the producer
+  uint8_t slot = tail;
+  if (slot == head)
+    return false;
+  *event = queue[slot];
+  tail = (slot + 1) & (MCP23XXX_EVENT_QUEUE_SIZE - 1);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Number of queued events.
+  @returns number of events waiting for pop() or drain()
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23XXX_Events::available() {
+  return (head - tail) & (MCP23XXX_EVENT_QUEUE_SIZE - 1);
+}
+
+/**************************************************************************/
+/*!
+  @brief Remove all queued events and pass them to the pin callbacks.
+  @returns number of events processed
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23XXX_Events::drain() {
+  MCP23XXX_Event event;
+  uint8_t count = 0;
+
+  while (pop(&event)) {
+    for (uint8_t pin = 0; pin < 16; pin++) {
+      if ((event.flags & ((uint16_t)1 << pin)) && callbacks[pin]) {
+        callbacks[pin](pin, (event.captured >> pin) & 1 ? HIGH : LOW,
+                       event.timestamp);
+      }
+    }
+    count++;
+  }
+
+  return count;
+}
+
+/**************************************************************************/
+/*!
+  @brief Number of events dropped because the queue was full.
+  @returns overflow count
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX_Events::overflows() { return overflowCount; }
@@ -0,0 +1,88 @@
+/*!
+ * @file Adafruit_MCP23XXX_Events.h
+ */
+
+#ifndef __ADAFRUIT_MCP23XXX_EVENTS_H__
+#define __ADAFRUIT_MCP23XXX_EVENTS_H__
+
+#include "Adafruit_MCP23XXX.h"
+
+#define MCP23XXX_EVENT_QUEUE_SIZE 16 //!< Queued events, must be power of 2
+
+// C++11 atomics order the queue between cores, not available on all
+// platforms (e.g. AVR, which has one core)
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#define MCP23XXX_EVENTS_ATOMIC //!< Queue indices are std::atomic
+#endif
+#endif
+
+#ifdef MCP23XXX_EVENTS_ATOMIC
+#include <atomic>
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Pin change event, as captured from INTF and INTCAP.
+*/
+/**************************************************************************/
+typedef struct {
+  uint32_t timestamp; ///< micros() when the INT line fired
+  uint16_t flags;     ///< Pins that caused the interrupt
+  uint16_t captured;  ///< Pin states at time of interrupt
+} MCP23XXX_Event;
+
+/*!
+    @brief  Per pin event callback.
+    @param pin pin that changed
+    @param level captured pin state, HIGH or LOW
+    @param timestamp micros() when the INT line fired
+*/
+typedef void (*MCP23XXX_EventCallback)(uint8_t pin, uint8_t level,
+                                       uint32_t timestamp);
+
+/**************************************************************************/
+/*!
+    @brief  Interrupt driven pin change event queue. A fixed size single
+    producer / single consumer ring buffer, no heap and no locking. Where
+    C++11 atomics are available the producer and consumer may run on
+    different cores or tasks. Otherwise, as on AVR, they must share one
+    core, for example an ISR and loop().
+*/
+/**************************************************************************/
+class Adafruit_MCP23XXX_Events {
+public:
+  Adafruit_MCP23XXX_Events(Adafruit_MCP23XXX *mcp);
+
+  void onPin(uint8_t pin, MCP23XXX_EventCallback callback);
+
+  // producer
+  void handleInterrupt();
+  bool capture();
+
+  // consumer
+  bool pop(MCP23XXX_Event *event);
+  uint8_t available();
+  uint8_t drain();
+
+  uint32_t overflows();
+
+private:
+  Adafruit_MCP23XXX *mcp;
+  MCP23XXX_EventCallback callbacks[16];
+  MCP23XXX_Event queue[MCP23XXX_EVENT_QUEUE_SIZE];
+#ifdef MCP23XXX_EVENTS_ATOMIC
+  std::atomic<uint8_t> head{0};
+  std::atomic<uint8_t> tail{0};
+  std::atomic<bool> pending{false};
+  std::atomic<uint32_t> overflowCount{0};
+#else
+  volatile uint8_t head = 0;
+  volatile uint8_t tail = 0;
+  volatile bool pending = false;
+  volatile uint32_t overflowCount = 0;
+#endif
+  volatile uint32_t pendingTime = 0;
+};
+
+#endif
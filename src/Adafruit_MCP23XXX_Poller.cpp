@@ -0,0 +1,145 @@
+/*!
+ * @file Adafruit_MCP23XXX_Poller.cpp
+ */
+
+#include "Adafruit_MCP23XXX_Poller.h"
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param mcp Pointer to initialized MCP23XXX
+  @param minInterval shortest poll interval in microseconds, used while
+  pins are changing
+  @param maxInterval longest poll interval in microseconds, reached while
+  pins are idle
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX_Poller::Adafruit_MCP23XXX_Poller(Adafruit_MCP23XXX *mcp,
+                                                   uint32_t minInterval,
+                                                   uint32_t maxInterval) {
+  this->mcp = mcp;
+  this->minInterval = minInterval ? minInterval : 1;
+  this->maxInterval =
+      (maxInterval < this->minInterval) ? this->minInterval : maxInterval;
+  interval = this->minInterval;
+  for (uint8_t i = 0; i < MCP23XXX_POLL_SUBSCRIBERS; i++) {
+    masks[i] = 0;
+    callbacks[i] = nullptr;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief Call a function when any of the given pins change.
+  @param mask pins to watch, bit 0 is pin 0
+  @param callback function to call
+  @return true if subscribed, false if there are too many subscriptions.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Poller::subscribe(uint16_t mask,
+                                         MCP23XXX_ChangeCallback callback) {
+  for (uint8_t i = 0; i < MCP23XXX_POLL_SUBSCRIBERS; i++) {
+    if (!callbacks[i]) {
+      masks[i] = mask;
+      callbacks[i] = callback;
+      watched |= mask;
+      primed = false; // take a new baseline
+      return true;
+    }
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+  @brief Remove all subscriptions of a function.
+  @param callback function to remove
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Poller::unsubscribe(MCP23XXX_ChangeCallback callback) {
+  watched = 0;
+  for (uint8_t i = 0; i < MCP23XXX_POLL_SUBSCRIBERS; i++) {
+    if (callbacks[i] == callback) {
+      masks[i] = 0;
+      callbacks[i] = nullptr;
+    }
+    watched |= masks[i];
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief Read the watched ports if the poll interval has passed, and call
+  subscribers of changed pins. Call this often from loop(). If the read
+  fails, the last pin states are kept and no subscriber is called.
+  @return true if the ports were read, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Poller::poll() {
+  Adafruit_MCP23XXX *dev = mcp;
+  uint32_t now = micros();
+  uint8_t gpio[2] = {0, 0};
+  bool ok;
+
+  if (!watched || (primed && now - lastPoll < interval))
+    return false;
+  lastPoll = now;
+
+  // read only the ports with watched pins
+  if (!(watched & 0xFF00))
+    ok = dev->readRegisters(MCP23XXX_GPIO, &gpio[0], 1, 0);
+  else if (!(watched & 0x00FF))
+    ok = dev->readRegisters(MCP23XXX_GPIO, &gpio[1], 1, 1);
+  else
+    ok = dev->readRegisterBlock(MCP23XXX_GPIO, gpio, 1);
+  busMicros += micros() - now;
+  if (!ok)
+    return false;
+  reads++;
+
+  uint16_t values = gpio[0] | ((uint16_t)gpio[1] << 8);
+  uint16_t changed = (values ^ last) & watched;
+  last = values;
+  if (!primed) {
+    primed = true;
+    return true;
+  }
+
+  if (!changed) {
+    // idle, back off
+    interval = (interval > maxInterval / 2) ? maxInterval : interval * 2;
+    return true;
+  }
+  interval = minInterval;
+
+  for (uint8_t i = 0; i < MCP23XXX_POLL_SUBSCRIBERS; i++) {
+    if (callbacks[i] && (changed & masks[i]))
+      callbacks[i](changed & masks[i], values);
+  }
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief Get the current poll interval.
+  @returns interval in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX_Poller::getInterval() { return interval; }
+
+/**************************************************************************/
+/*!
+  @brief Number of bus reads done.
+  @returns read count
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX_Poller::getReads() { return reads; }
+
+/**************************************************************************/
+/*!
+  @brief Bus time spent polling.
+  @returns cumulative read time in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MCP23XXX_Poller::getBusMicros() { return busMicros; }
@@ -0,0 +1,55 @@
+/*!
+ * @file Adafruit_MCP23XXX_Poller.h
+ */
+
+#ifndef __ADAFRUIT_MCP23XXX_POLLER_H__
+#define __ADAFRUIT_MCP23XXX_POLLER_H__
+
+#include "Adafruit_MCP23XXX.h"
+
+#define MCP23XXX_POLL_SUBSCRIBERS 4 //!< Maximum subscriptions
+
+/*!
+    @brief  Pin change callback.
+    @param changed subscribed pins that changed, bit 0 is pin 0
+    @param values current pin states, bit 0 is pin 0
+*/
+typedef void (*MCP23XXX_ChangeCallback)(uint16_t changed, uint16_t values);
+
+/**************************************************************************/
+/*!
+    @brief  Change detection by polling, for boards without the INT line
+    wired. Only ports with subscribed pins are read, and the poll interval
+    shrinks while pins change and grows while they are idle.
+*/
+/**************************************************************************/
+class Adafruit_MCP23XXX_Poller {
+public:
+  Adafruit_MCP23XXX_Poller(Adafruit_MCP23XXX *mcp,
+                           uint32_t minInterval = 1000,
+                           uint32_t maxInterval = 64000);
+
+  bool subscribe(uint16_t mask, MCP23XXX_ChangeCallback callback);
+  void unsubscribe(MCP23XXX_ChangeCallback callback);
+  bool poll();
+
+  uint32_t getInterval();
+  uint32_t getReads();
+  uint32_t getBusMicros();
+
+private:
+  Adafruit_MCP23XXX *mcp;
+  uint16_t masks[MCP23XXX_POLL_SUBSCRIBERS];
+  MCP23XXX_ChangeCallback callbacks[MCP23XXX_POLL_SUBSCRIBERS];
+  uint16_t watched = 0;
+  uint16_t last = 0;
+  bool primed = false;
+  uint32_t minInterval;
+  uint32_t maxInterval;
+  uint32_t interval;
+  uint32_t lastPoll = 0;
+  uint32_t reads = 0;
+  uint32_t busMicros = 0;
+};
+
+#endif
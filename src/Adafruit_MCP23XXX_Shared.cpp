@@ -0,0 +1,140 @@
+/*!
+ * @file Adafruit_MCP23XXX_Shared.cpp
+ */
+
+#include "Adafruit_MCP23XXX_Shared.h"
+
+#ifdef MCP23XXX_HAS_SHARED
+
+/**************************************************************************/
+/*!
+  @brief ctor.
+  @param mcp Pointer to initialized MCP23XXX
+  @param lock lock for the bus the chip is on
+*/
+/**************************************************************************/
+Adafruit_MCP23XXX_Shared::Adafruit_MCP23XXX_Shared(Adafruit_MCP23XXX *mcp,
+                                                   MCP23XXX_BusLock *lock)
+    : image(0) {
+  this->mcp = mcp;
+  this->busLock = lock;
+}
+
+/**************************************************************************/
+/*!
+  @brief Load the output image from the chip. Call once, before any task
+  uses the chip.
+  @return true if successful, otherwise false. The image is left unchanged
+  if the chip could not be read.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Shared::begin() {
+  Adafruit_MCP23XXX *dev = mcp;
+  uint8_t olat[2] = {0, 0};
+
+  busLock->lock();
+  bool ok = dev->readRegisterBlock(MCP23XXX_OLAT, olat, 1);
+  if (ok) {
+    written = olat[0] | (olat[1] << 8);
+    image.store(written);
+  }
+  busLock->unlock();
+
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+  @brief Configure a pin, see Adafruit_MCP23XXX::pinMode().
+  @param pin the Arduino pin number to set the mode of
+  @param mode INPUT, OUTPUT, or INPUT_PULLUP
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Shared::pinMode(uint8_t pin, uint8_t mode) {
+  busLock->lock();
+  mcp->pinMode(pin, mode);
+  busLock->unlock();
+}
+
+/**************************************************************************/
+/*!
+  @brief Read a pin, see Adafruit_MCP23XXX::digitalRead().
+  @param pin the Arduino pin number you want to read
+  @returns HIGH or LOW
+*/
+/**************************************************************************/
+uint8_t Adafruit_MCP23XXX_Shared::digitalRead(uint8_t pin) {
+  busLock->lock();
+  uint8_t value = mcp->digitalRead(pin);
+  busLock->unlock();
+
+  return value;
+}
+
+/**************************************************************************/
+/*!
+  @brief Write a pin and flush.
+  @param pin the Arduino pin number
+  @param value HIGH or LOW
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Shared::digitalWrite(uint8_t pin, uint8_t value) {
+  return digitalWriteMask((uint16_t)1 << pin, (value == LOW) ? 0 : 0xFFFF);
+}
+
+/**************************************************************************/
+/*!
+  @brief Write several pins and flush.
+  @param mask bit mask of pins to write, bit 0 is pin 0.
+  @param values pin states to write, bit 0 is pin 0.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Shared::digitalWriteMask(uint16_t mask,
+                                                uint16_t values) {
+  setPins(mask, values);
+  return flush();
+}
+
+/**************************************************************************/
+/*!
+  @brief Change pins in the output image only, without locking. Use
+  flush() to write them.
+  @param mask bit mask of pins to write, bit 0 is pin 0.
+  @param values pin states to write, bit 0 is pin 0.
+*/
+/**************************************************************************/
+void Adafruit_MCP23XXX_Shared::setPins(uint16_t mask, uint16_t values) {
+  uint32_t expected = image.load();
+
+  while (!image.compare_exchange_weak(expected,
+                                      (expected & ~mask) | (values & mask))) {
+    // expected was updated with the current image, retry
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief Write the output image to the chip if it differs from what was
+  last written. Changes made by other tasks are written too.
+  @return true if successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_MCP23XXX_Shared::flush() {
+  Adafruit_MCP23XXX *dev = mcp;
+  bool ok = true;
+
+  busLock->lock();
+  uint32_t snapshot = image.load();
+  if (snapshot != written) {
+    ok = dev->writeRegisterPorts(MCP23XXX_OLAT, snapshot);
+    if (ok)
+      written = snapshot;
+  }
+  busLock->unlock();
+
+  return ok;
+}
+
+#endif // MCP23XXX_HAS_SHARED
@@ -0,0 +1,67 @@
+/*!
+ * @file Adafruit_MCP23XXX_Shared.h
+ */
+
+#ifndef __ADAFRUIT_MCP23XXX_SHARED_H__
+#define __ADAFRUIT_MCP23XXX_SHARED_H__
+
+#include "Adafruit_MCP23XXX.h"
+
+// needs C++11 atomics, not available on all platforms (e.g. AVR)
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#define MCP23XXX_HAS_SHARED //!< Adafruit_MCP23XXX_Shared is available
+#endif
+#endif
+
+#ifdef MCP23XXX_HAS_SHARED
+
+#include <atomic>
+
+/**************************************************************************/
+/*!
+    @brief  Lock serializing access to one bus. Implement with the
+    platform mutex, for example a FreeRTOS semaphore or std::mutex, and
+    share one instance between all chips on the same bus.
+*/
+/**************************************************************************/
+class MCP23XXX_BusLock {
+public:
+  virtual ~MCP23XXX_BusLock() {}
+  /*! @brief Wait until the bus is free and take it. */
+  virtual void lock() = 0;
+  /*! @brief Release the bus. */
+  virtual void unlock() = 0;
+};
+
+/**************************************************************************/
+/*!
+    @brief  Wrapper for using one chip from several tasks or cores. Output
+    changes are merged into an atomic image of the output latches without
+    locking, then flushed to the chip under the bus lock; a task that finds
+    its change already flushed by another skips the bus write.
+*/
+/**************************************************************************/
+class Adafruit_MCP23XXX_Shared {
+public:
+  Adafruit_MCP23XXX_Shared(Adafruit_MCP23XXX *mcp, MCP23XXX_BusLock *lock);
+
+  bool begin();
+
+  void pinMode(uint8_t pin, uint8_t mode);
+  uint8_t digitalRead(uint8_t pin);
+  bool digitalWrite(uint8_t pin, uint8_t value);
+  bool digitalWriteMask(uint16_t mask, uint16_t values);
+  void setPins(uint16_t mask, uint16_t values);
+  bool flush();
+
+private:
+  Adafruit_MCP23XXX *mcp;
+  MCP23XXX_BusLock *busLock;
+  std::atomic<uint32_t> image;
+  uint32_t written = 0; // protected by busLock
+};
+
+#endif // MCP23XXX_HAS_SHARED
+
+#endif